@@ -0,0 +1,621 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+
+/* Host benchmark of the port against the BG770 emulator. Each result is printed as one JSON line so CI can
+ * compare them across driver releases. The emulator answers without latency, the times are the cost of the
+ * port, the common library and the kernel. Only DNS takes BENCHMARK_DNS_LATENCY_MS, as a network would. */
+
+/* The config header is always included first. */
+#include "cellular_config.h"
+#include "cellular_config_defaults.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cellular_platform.h"
+#include "cellular_api.h"
+#include "cellular_common.h"
+#include "cellular_bg770.h"
+#include "cellular_bg770_sim.h"
+
+/*-----------------------------------------------------------*/
+
+#ifndef BENCHMARK_SIGNAL_QUERY_COUNT
+    #define BENCHMARK_SIGNAL_QUERY_COUNT    ( 100U )
+#endif
+
+#ifndef BENCHMARK_AT_ROUND_TRIP_COUNT
+    #define BENCHMARK_AT_ROUND_TRIP_COUNT   ( 300U )
+#endif
+
+/* Payload sent and read back through one TCP socket. */
+#ifndef BENCHMARK_SOCKET_BYTES
+    #define BENCHMARK_SOCKET_BYTES          ( 65536U )
+#endif
+
+#ifndef BENCHMARK_SOCKET_CHUNK_SIZE
+    #define BENCHMARK_SOCKET_CHUNK_SIZE     ( 1024U )
+#endif
+
+/* Times the URC trace is replayed. */
+#ifndef BENCHMARK_URC_TRACE_ROUNDS
+    #define BENCHMARK_URC_TRACE_ROUNDS      ( 250U )
+#endif
+
+#ifndef BENCHMARK_DNS_LATENCY_MS
+    #define BENCHMARK_DNS_LATENCY_MS        ( 100U )
+#endif
+
+/* Host names resolved one after the other, then all at once. */
+#ifndef BENCHMARK_DNS_QUERY_COUNT
+    #define BENCHMARK_DNS_QUERY_COUNT       ( CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES )
+#endif
+
+#ifndef BENCHMARK_STACK_SIZE
+    #define BENCHMARK_STACK_SIZE            ( PLATFORM_THREAD_DEFAULT_STACK_SIZE )
+#endif
+
+/* Longest wait for an asynchronous event such as the +QIOPEN URC. */
+#define BENCHMARK_EVENT_TIMEOUT_MS          ( 1000U )
+
+#define BENCHMARK_HOST_NAME_MAX_SIZE        ( 32U )
+
+/* defaultLatencyMs, bootDelayMs, throughputBytesPerSecond, connectLatencyMs, dnsLatencyMs, pRules, ruleCount,
+ * simulatedClock. */
+#define BENCHMARK_SIM_CONFIG                { 0U, 1U, 0U, 0U, BENCHMARK_DNS_LATENCY_MS, NULL, 0U, false }
+
+/*-----------------------------------------------------------*/
+
+/* One host name resolved by its own thread. */
+typedef struct benchmarkDnsLookup
+{
+    CellularHandle_t cellularHandle;
+    char hostName[ BENCHMARK_HOST_NAME_MAX_SIZE ];
+    char resolvedAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ];
+    CellularError_t cellularStatus;
+    volatile bool done;
+} benchmarkDnsLookup_t;
+
+/*-----------------------------------------------------------*/
+
+/* URCs of a network flap. Each round ends with the csq URC whose callback the benchmark counts. */
+static const char * const benchmarkUrcTrace[] =
+{
+    "+CEREG: 2",
+    "+QIND: \"act\",\"eMTC\"",
+    "+CEREG: 1",
+    "+QIND: \"csq\",20,99"
+};
+
+static volatile uint32_t signalCallbackCount = 0;
+
+static benchmarkDnsLookup_t benchmarkDnsLookups[ BENCHMARK_DNS_QUERY_COUNT ];
+
+/* Data sent, and injected for the socket to read. */
+static uint8_t benchmarkPayload[ CELLULAR_BG770_SIM_SOCKET_BUFFER_SIZE ];
+
+static uint8_t benchmarkBuffer[ BENCHMARK_SOCKET_CHUNK_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+static uint32_t _ticksToUs( TickType_t ticks )
+{
+    return ( uint32_t ) ( ( ( uint64_t ) ticks * 1000000U ) / configTICK_RATE_HZ );
+}
+
+/*-----------------------------------------------------------*/
+
+static void _printResult( const char * pName,
+                          uint32_t iterations,
+                          TickType_t elapsedTicks,
+                          CellularError_t cellularStatus )
+{
+    ( void ) printf( "{\"benchmark\":\"%s\",\"iterations\":%u,\"total_us\":%u,\"status\":%d}\n",
+                     pName, ( unsigned int ) iterations, ( unsigned int ) _ticksToUs( elapsedTicks ),
+                     ( int ) cellularStatus );
+}
+
+/*-----------------------------------------------------------*/
+
+static void _printThroughput( const char * pName,
+                              uint32_t byteCount,
+                              TickType_t elapsedTicks,
+                              CellularError_t cellularStatus )
+{
+    uint32_t elapsedUs = _ticksToUs( elapsedTicks );
+
+    ( void ) printf( "{\"benchmark\":\"%s\",\"bytes\":%u,\"total_us\":%u,\"bytes_per_second\":%u,\"status\":%d}\n",
+                     pName, ( unsigned int ) byteCount, ( unsigned int ) elapsedUs,
+                     ( unsigned int ) ( ( elapsedUs == 0U ) ? 0U : ( ( ( uint64_t ) byteCount * 1000000U ) / elapsedUs ) ),
+                     ( int ) cellularStatus );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Polls, the flags are set from URC callbacks. */
+static bool _waitForFlag( const volatile bool * pFlag )
+{
+    TickType_t startTicks = xTaskGetTickCount();
+
+    while( ( *pFlag == false ) && ( ( xTaskGetTickCount() - startTicks ) < pdMS_TO_TICKS( BENCHMARK_EVENT_TIMEOUT_MS ) ) )
+    {
+        vTaskDelay( 1U );
+    }
+
+    return *pFlag;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _socketOpenCallback( CellularUrcEvent_t urcEvent,
+                                 CellularSocketHandle_t socketHandle,
+                                 void * pCallbackContext )
+{
+    ( void ) socketHandle;
+
+    if( urcEvent == CELLULAR_URC_SOCKET_OPENED )
+    {
+        *( ( volatile bool * ) pCallbackContext ) = true;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void _signalStrengthChangedCallback( CellularUrcEvent_t urcEvent,
+                                            const CellularSignalInfo_t * pSignalInfo,
+                                            void * pCallbackContext )
+{
+    ( void ) urcEvent;
+    ( void ) pSignalInfo;
+    ( void ) pCallbackContext;
+
+    signalCallbackCount++;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Replays the trace as fast as the emulator takes it. URCs are handled in order, the last csq callback
+ * marks the end of the trace. The emulator delivers once per CELLULAR_BG770_SIM_TICK_MS, so the rate is a
+ * lower bound of what the reader task can dispatch. */
+static CellularError_t _benchmarkUrcDispatch( CellularHandle_t cellularHandle )
+{
+    const uint32_t traceLength = ( uint32_t ) ( sizeof( benchmarkUrcTrace ) / sizeof( benchmarkUrcTrace[ 0 ] ) );
+    const uint32_t urcCount = traceLength * BENCHMARK_URC_TRACE_ROUNDS;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    TickType_t startTicks = 0;
+    TickType_t elapsedTicks = 0;
+    TickType_t progressTicks = 0;
+    uint32_t injectedCount = 0;
+    uint32_t seenCount = 0;
+    uint32_t elapsedUs = 0;
+
+    signalCallbackCount = 0;
+    cellularStatus = Cellular_RegisterUrcSignalStrengthChangedCallback( cellularHandle, _signalStrengthChangedCallback, NULL );
+    startTicks = xTaskGetTickCount();
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( injectedCount < urcCount ) )
+    {
+        /* A full emulator queue takes the line on the next try. */
+        if( CellularBg770Sim_InjectUrc( benchmarkUrcTrace[ injectedCount % traceLength ], 0U ) )
+        {
+            injectedCount++;
+        }
+        else
+        {
+            vTaskDelay( 1U );
+        }
+    }
+
+    progressTicks = xTaskGetTickCount();
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( signalCallbackCount < BENCHMARK_URC_TRACE_ROUNDS ) &&
+           ( ( xTaskGetTickCount() - progressTicks ) < pdMS_TO_TICKS( BENCHMARK_EVENT_TIMEOUT_MS ) ) )
+    {
+        if( signalCallbackCount != seenCount )
+        {
+            seenCount = signalCallbackCount;
+            progressTicks = xTaskGetTickCount();
+        }
+
+        vTaskDelay( 1U );
+    }
+
+    elapsedTicks = xTaskGetTickCount() - startTicks;
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( signalCallbackCount < BENCHMARK_URC_TRACE_ROUNDS ) )
+    {
+        cellularStatus = CELLULAR_TIMEOUT;
+    }
+
+    elapsedUs = _ticksToUs( elapsedTicks );
+    ( void ) printf( "{\"benchmark\":\"urc_dispatch\",\"urcs\":%u,\"total_us\":%u,\"urcs_per_second\":%u,\"status\":%d}\n",
+                     ( unsigned int ) urcCount, ( unsigned int ) elapsedUs,
+                     ( unsigned int ) ( ( elapsedUs == 0U ) ? 0U : ( ( ( uint64_t ) urcCount * 1000000U ) / elapsedUs ) ),
+                     ( int ) cellularStatus );
+
+    ( void ) Cellular_RegisterUrcSignalStrengthChangedCallback( cellularHandle, NULL, NULL );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* A bare "AT", the cost of one request through the common library without a response to parse. */
+static TickType_t _benchmarkAtRoundTrip( CellularHandle_t cellularHandle,
+                                         CellularError_t * pCellularStatus )
+{
+    TickType_t startTicks = xTaskGetTickCount();
+    TickType_t elapsedTicks = 0;
+    uint32_t i = 0;
+
+    for( i = 0; ( i < BENCHMARK_AT_ROUND_TRIP_COUNT ) && ( *pCellularStatus == CELLULAR_SUCCESS ); i++ )
+    {
+        *pCellularStatus = Cellular_ATCommandRaw( cellularHandle, NULL, "AT", CELLULAR_AT_NO_RESULT, NULL, NULL, 0U );
+    }
+
+    elapsedTicks = xTaskGetTickCount() - startTicks;
+    _printResult( "at_round_trip", i, elapsedTicks, *pCellularStatus );
+
+    return elapsedTicks;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Three requests per call: the RAT query, AT+QCSQ and AT+CSQ. Without the RAT query only the last two. */
+static TickType_t _benchmarkSignalQuery( CellularHandle_t cellularHandle,
+                                         bool skipRatQuery,
+                                         CellularError_t * pCellularStatus )
+{
+    CellularSignalInfo_t signalInfo = { 0 };
+    TickType_t startTicks = xTaskGetTickCount();
+    TickType_t elapsedTicks = 0;
+    uint32_t i = 0;
+
+    for( i = 0; ( i < BENCHMARK_SIGNAL_QUERY_COUNT ) && ( *pCellularStatus == CELLULAR_SUCCESS ); i++ )
+    {
+        *pCellularStatus = ( skipRatQuery ) ? Cellular_GetSignalInfoSkipRatQuery( cellularHandle, &signalInfo ) :
+                           Cellular_GetSignalInfo( cellularHandle, &signalInfo );
+    }
+
+    elapsedTicks = xTaskGetTickCount() - startTicks;
+    _printResult( ( skipRatQuery ) ? "signal_query_skip_rat" : "signal_query", i, elapsedTicks, *pCellularStatus );
+
+    return elapsedTicks;
+}
+
+/*-----------------------------------------------------------*/
+
+/* What a signal query request costs beyond a bare round trip, mostly the response parsing of the port. */
+static void _printParserCost( TickType_t roundTripTicks,
+                              TickType_t signalQueryTicks )
+{
+    int64_t roundTripUs = ( int64_t ) _ticksToUs( roundTripTicks ) / BENCHMARK_AT_ROUND_TRIP_COUNT;
+    int64_t requestUs = ( int64_t ) _ticksToUs( signalQueryTicks ) / ( BENCHMARK_SIGNAL_QUERY_COUNT * 3U );
+    int64_t parserUs = requestUs - roundTripUs;
+
+    ( void ) printf( "{\"benchmark\":\"parser_cost\",\"request_us\":%d,\"round_trip_us\":%d,\"parser_us\":%d}\n",
+                     ( int ) requestUs, ( int ) roundTripUs, ( int ) ( ( parserUs > 0 ) ? parserUs : 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _benchmarkSocketSend( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    TickType_t startTicks = xTaskGetTickCount();
+    uint32_t totalSent = 0;
+    uint32_t sentLength = 0;
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( totalSent < BENCHMARK_SOCKET_BYTES ) )
+    {
+        sentLength = 0;
+        cellularStatus = Cellular_SocketSend( cellularHandle, socketHandle, benchmarkPayload,
+                                              BENCHMARK_SOCKET_CHUNK_SIZE, &sentLength );
+
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( sentLength == 0U ) )
+        {
+            cellularStatus = CELLULAR_TIMEOUT;
+        }
+
+        totalSent += sentLength;
+    }
+
+    _printThroughput( "socket_send", totalSent, xTaskGetTickCount() - startTicks, cellularStatus );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The emulator holds CELLULAR_BG770_SIM_SOCKET_BUFFER_SIZE bytes, the data is injected one buffer at a time. */
+static CellularError_t _benchmarkSocketRecv( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    TickType_t startTicks = xTaskGetTickCount();
+    uint32_t totalReceived = 0;
+    uint32_t roundLength = 0;
+    uint32_t roundReceived = 0;
+    uint32_t receivedLength = 0;
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( totalReceived < BENCHMARK_SOCKET_BYTES ) )
+    {
+        roundLength = BENCHMARK_SOCKET_BYTES - totalReceived;
+
+        if( roundLength > sizeof( benchmarkPayload ) )
+        {
+            roundLength = sizeof( benchmarkPayload );
+        }
+
+        ( void ) CellularBg770Sim_InjectSocketData( ( uint8_t ) socketHandle->socketId, benchmarkPayload, roundLength );
+        roundReceived = 0;
+
+        while( ( cellularStatus == CELLULAR_SUCCESS ) && ( roundReceived < roundLength ) )
+        {
+            receivedLength = 0;
+            cellularStatus = Cellular_SocketRecv( cellularHandle, socketHandle, benchmarkBuffer,
+                                                  sizeof( benchmarkBuffer ), &receivedLength );
+
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( receivedLength == 0U ) )
+            {
+                cellularStatus = CELLULAR_TIMEOUT;
+            }
+
+            roundReceived += receivedLength;
+        }
+
+        totalReceived += roundReceived;
+    }
+
+    _printThroughput( "socket_recv", totalReceived, xTaskGetTickCount() - startTicks, cellularStatus );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _benchmarkSocketThroughput( CellularHandle_t cellularHandle )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularSocketHandle_t socketHandle = NULL;
+    volatile bool socketOpened = false;
+    const CellularSocketAddress_t remoteAddress = { { CELLULAR_IP_ADDRESS_V4, "10.0.0.1" }, 5000U };
+
+    cellularStatus = Cellular_CreateSocket( cellularHandle, 1U, CELLULAR_SOCKET_DOMAIN_AF_INET,
+                                            CELLULAR_SOCKET_TYPE_STREAM, CELLULAR_SOCKET_PROTOCOL_TCP, &socketHandle );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = Cellular_SocketRegisterSocketOpenCallback( cellularHandle, socketHandle, _socketOpenCallback,
+                                                                    ( void * ) &socketOpened );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = Cellular_SocketConnect( cellularHandle, socketHandle, CELLULAR_ACCESSMODE_BUFFER, &remoteAddress );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( _waitForFlag( &socketOpened ) == false ) )
+    {
+        cellularStatus = CELLULAR_TIMEOUT;
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _benchmarkSocketSend( cellularHandle, socketHandle );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _benchmarkSocketRecv( cellularHandle, socketHandle );
+    }
+
+    if( socketHandle != NULL )
+    {
+        ( void ) Cellular_SocketClose( cellularHandle, socketHandle );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _dnsLookupThread( void * pArgument )
+{
+    benchmarkDnsLookup_t * pLookup = ( benchmarkDnsLookup_t * ) pArgument;
+
+    pLookup->cellularStatus = Cellular_GetHostByName( pLookup->cellularHandle, 1U, pLookup->hostName,
+                                                      pLookup->resolvedAddress );
+    pLookup->done = true;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Every name is new, the DNS cache does not answer any of them. */
+static void _prepareDnsLookups( CellularHandle_t cellularHandle,
+                                const char * pPrefix )
+{
+    uint32_t i = 0;
+
+    for( i = 0; i < BENCHMARK_DNS_QUERY_COUNT; i++ )
+    {
+        benchmarkDnsLookups[ i ].cellularHandle = cellularHandle;
+        ( void ) snprintf( benchmarkDnsLookups[ i ].hostName, BENCHMARK_HOST_NAME_MAX_SIZE, "%s%u.example.com",
+                           pPrefix, ( unsigned int ) i );
+        benchmarkDnsLookups[ i ].cellularStatus = CELLULAR_SUCCESS;
+        benchmarkDnsLookups[ i ].done = false;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* The same number of names resolved one after the other and then from one thread each. With concurrent
+ * queries the parallel run takes about one DNS latency instead of one per name. */
+static CellularError_t _benchmarkDnsResolution( CellularHandle_t cellularHandle )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    TickType_t startTicks = 0;
+    TickType_t timeoutTicks = 0;
+    uint32_t i = 0;
+    bool allDone = false;
+
+    _prepareDnsLookups( cellularHandle, "serial" );
+    startTicks = xTaskGetTickCount();
+
+    for( i = 0; ( i < BENCHMARK_DNS_QUERY_COUNT ) && ( cellularStatus == CELLULAR_SUCCESS ); i++ )
+    {
+        _dnsLookupThread( &benchmarkDnsLookups[ i ] );
+        cellularStatus = benchmarkDnsLookups[ i ].cellularStatus;
+    }
+
+    _printResult( "dns_serial", i, xTaskGetTickCount() - startTicks, cellularStatus );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        _prepareDnsLookups( cellularHandle, "parallel" );
+        startTicks = xTaskGetTickCount();
+
+        for( i = 0; ( i < BENCHMARK_DNS_QUERY_COUNT ) && ( cellularStatus == CELLULAR_SUCCESS ); i++ )
+        {
+            if( Platform_CreateDetachedThread( _dnsLookupThread, &benchmarkDnsLookups[ i ], PLATFORM_THREAD_DEFAULT_PRIORITY,
+                                               BENCHMARK_STACK_SIZE ) != true )
+            {
+                /* The threads already started still finish on their own. */
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        timeoutTicks = pdMS_TO_TICKS( BENCHMARK_EVENT_TIMEOUT_MS + ( BENCHMARK_DNS_LATENCY_MS * BENCHMARK_DNS_QUERY_COUNT ) );
+
+        while( ( cellularStatus == CELLULAR_SUCCESS ) && ( allDone == false ) &&
+               ( ( xTaskGetTickCount() - startTicks ) < timeoutTicks ) )
+        {
+            vTaskDelay( 1U );
+            allDone = true;
+
+            for( i = 0; i < BENCHMARK_DNS_QUERY_COUNT; i++ )
+            {
+                allDone = ( allDone ) && ( benchmarkDnsLookups[ i ].done );
+            }
+        }
+
+        for( i = 0; ( i < BENCHMARK_DNS_QUERY_COUNT ) && ( cellularStatus == CELLULAR_SUCCESS ); i++ )
+        {
+            cellularStatus = ( benchmarkDnsLookups[ i ].done ) ? benchmarkDnsLookups[ i ].cellularStatus : CELLULAR_TIMEOUT;
+        }
+
+        _printResult( "dns_parallel", BENCHMARK_DNS_QUERY_COUNT, xTaskGetTickCount() - startTicks, cellularStatus );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _benchmarkThread( void * pArgument )
+{
+    const CellularBg770SimConfig_t simConfig = BENCHMARK_SIM_CONFIG;
+    CellularHandle_t cellularHandle = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularBg770SimStats_t simStats = { 0 };
+    TickType_t startTicks = 0;
+    TickType_t roundTripTicks = 0;
+    TickType_t signalQueryTicks = 0;
+
+    ( void ) pArgument;
+
+    CellularBg770Sim_Configure( &simConfig );
+
+    startTicks = xTaskGetTickCount();
+    cellularStatus = Cellular_Init( &cellularHandle, &CellularBg770SimCommInterface );
+    _printResult( "init", 1U, xTaskGetTickCount() - startTicks, cellularStatus );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        roundTripTicks = _benchmarkAtRoundTrip( cellularHandle, &cellularStatus );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        signalQueryTicks = _benchmarkSignalQuery( cellularHandle, false, &cellularStatus );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        ( void ) _benchmarkSignalQuery( cellularHandle, true, &cellularStatus );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        _printParserCost( roundTripTicks, signalQueryTicks );
+        cellularStatus = _benchmarkUrcDispatch( cellularHandle );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _benchmarkDnsResolution( cellularHandle );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _benchmarkSocketThroughput( cellularHandle );
+    }
+
+    if( cellularHandle != NULL )
+    {
+        ( void ) Cellular_Cleanup( cellularHandle );
+    }
+
+    CellularBg770Sim_GetStats( &simStats );
+    ( void ) printf( "{\"benchmark\":\"emulator\",\"commands\":%u,\"urcs\":%u,\"bytes_from_host\":%u,\"bytes_to_host\":%u,"
+                     "\"dropped_output\":%u}\n",
+                     ( unsigned int ) simStats.commandCount, ( unsigned int ) simStats.urcCount,
+                     ( unsigned int ) simStats.bytesFromHost, ( unsigned int ) simStats.bytesToHost,
+                     ( unsigned int ) simStats.droppedOutputCount );
+
+    exit( ( cellularStatus == CELLULAR_SUCCESS ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    if( Platform_CreateDetachedThread( _benchmarkThread, NULL, PLATFORM_THREAD_DEFAULT_PRIORITY,
+                                       BENCHMARK_STACK_SIZE ) == true )
+    {
+        /* Returns only if the scheduler could not start, the benchmark exits the process itself. */
+        vTaskStartScheduler();
+    }
+
+    return EXIT_FAILURE;
+}
+
+/*-----------------------------------------------------------*/
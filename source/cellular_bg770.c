@@ -34,6 +34,7 @@
 #endif
 #include "cellular_config_defaults.h"
 #include "cellular_platform.h"
+#include "cellular_api.h"
 #include "cellular_common.h"
 #include "cellular_common_portable.h"
 #include "cellular_bg770.h"
@@ -45,6 +46,17 @@
 #define ENABLE_MODULE_UE_RETRY_EXP_BACKOFF_INTER_COMMAND_BASE_MS    ( 1000UL )
 #define BG770_NWSCANSEQ_CMD_MAX_SIZE       ( 30U ) /* Need at least the length of AT+QCFG="nwscanseq",020301,1\0. */
 
+#define AT_PRIORITY_EVENT_BIT( priorityClass )    ( ( PlatformEventGroup_EventBits ) ( 1UL << ( uint32_t ) ( priorityClass ) ) )
+
+#define AUTO_PSM_EVT_MASK_STOP             ( 0x0001UL )
+#define AUTO_PSM_EVT_MASK_STOPPED          ( 0x0002UL )
+#define AUTO_PSM_STOP_TIMEOUT_ticks        ( pdMS_TO_TICKS( 10000U ) )    /* Between warnings, the stop itself is waited for. */
+
+#define HEALTH_MONITOR_EVT_MASK_STOP       ( 0x0001UL )
+#define HEALTH_MONITOR_EVT_MASK_STOPPED    ( 0x0002UL )
+#define HEALTH_MONITOR_EVT_MASK_WAKE       ( 0x0004UL )
+#define HEALTH_MONITOR_STOP_TIMEOUT_ticks  ( pdMS_TO_TICKS( 10000U ) )    /* Between warnings, the stop itself is waited for. */
+
 #define BG770_MAX_SUPPORTED_LTE_BAND       ( 66U )
 #define BG770_MAX_SUPPORTED_NB_IOT_BAND    ( 66U )
 
@@ -173,6 +185,9 @@ static const TickType_t POST_APP_READY_WAIT_PERIOD_ticks = pdMS_TO_TICKS( 5000U
 
 static const TickType_t SHORT_DELAY_ticks = pdMS_TO_TICKS( 10U );
 
+/* Polling step of the port's waits when a clock is set, the kernel only wakes a task on its own tick. */
+static const TickType_t CLOCK_POLL_PERIOD_ticks = ( pdMS_TO_TICKS( 10U ) > 0U ) ? pdMS_TO_TICKS( 10U ) : 1U;
+
 /*-----------------------------------------------------------*/
 
 static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pContext,
@@ -263,10 +278,29 @@ static bool areRATScanSequencesEquivalent( const BG770RATScanSequence_t * sequen
 static bool tryBuildRATScanSequenceString( const BG770RATScanSequence_t * pRATScanSequence,
                                            char * out_pRATScanSequenceString, size_t maxStringLength );
 
+static void _resetSignalHistory( cellularModuleContext_t * pModuleContext );
+static void _autoPsmAtActivity( cellularModuleContext_t * pModuleContext,
+                                bool begin );
+static bool _isAutoPsmEntryDue( cellularModuleContext_t * pModuleContext );
+static void _autoPsmThread( void * pArgument );
+static void _autoPsmStop( cellularModuleContext_t * pModuleContext );
+static void _atPriorityWakeNext( cellularModuleContext_t * pModuleContext,
+                                 bool countPreempted );
+static bool _clockPollStep( TickType_t startTicks,
+                            TickType_t waitTicks );
+static void _atPriorityClose( cellularModuleContext_t * pModuleContext );
+static void _healthMonitorSample( cellularModuleContext_t * pModuleContext );
+static void _healthMonitorThread( void * pArgument );
+static void _healthMonitorStop( cellularModuleContext_t * pModuleContext );
+static bool _healthMonitorStopRequested( const cellularModuleContext_t * pModuleContext );
+
 /*-----------------------------------------------------------*/
 
 static cellularModuleContext_t cellularBg770Context = { 0 };
 
+/* NULL while the port runs on the FreeRTOS kernel time. */
+static const CellularBg770Clock_t * pCellularBg770Clock = NULL;
+
 static volatile bool configSkipPostHWFlowControlSetupIfChanged = false;
 static volatile CellularModuleFullInitSkippedResult_t fullInitSkippedResult = CELLULAR_FULL_INIT_SKIPPED_RESULT_ERROR;
 
@@ -397,7 +431,7 @@ static CellularError_t sendAtCommandWithRetryTimeoutParams( CellularContext_t *
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, *pAtReq, commandTimeoutMS );
@@ -438,7 +472,7 @@ static CellularError_t setRetryableSettingWithTimeoutParams( FuncRetryableSet_t
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             cellularStatus = ( * retryableSetFunction )( cellularHandle, commandTimeoutMS );
@@ -462,6 +496,21 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     bool mutexCreateStatus = false;
+    bool atPriorityMutexCreateStatus = false;
+    bool dnsCacheMutexCreateStatus = false;
+    bool dnsPendingMutexCreateStatus = false;
+    bool identityCacheMutexCreateStatus = false;
+    bool servingCellMutexCreateStatus = false;
+    bool signalHistoryMutexCreateStatus = false;
+    bool psmMutexCreateStatus = false;
+    bool deferredSendMutexCreateStatus = false;
+    bool autoPsmMutexCreateStatus = false;
+    bool edrxMutexCreateStatus = false;
+    bool healthMonitorMutexCreateStatus = false;
+    bool thermalMutexCreateStatus = false;
+    bool adaptiveChunkMutexCreateStatus = false;
+    bool urcDispatchMutexCreateStatus = false;
+    uint32_t i = 0;
 
     if( pContext == NULL )
     {
@@ -475,6 +524,8 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
     {
         /* Initialize the module context. */
         ( void ) memset( &cellularBg770Context, 0, sizeof( cellularModuleContext_t ) );
+        cellularBg770Context.simCardState = CELLULAR_SIM_CARD_UNKNOWN;
+        _resetSignalHistory( &cellularBg770Context );
 
         /* Create the mutex for DNS. */
         mutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.dnsQueryMutex, false );
@@ -484,12 +535,23 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
             cellularStatus = CELLULAR_NO_MEMORY;
         }
 
-        if (cellularStatus == CELLULAR_SUCCESS)
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            /* Create the queue for DNS. */
-            cellularBg770Context.pktDnsQueue = xQueueCreate( 1, sizeof( cellularDnsQueryResult_t ) );
+            /* Create the mutex for the pending DNS queries. */
+            dnsPendingMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.dnsPendingMutex, false );
 
-            if( cellularBg770Context.pktDnsQueue == NULL )
+            if( dnsPendingMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        for( i = 0; ( cellularStatus == CELLULAR_SUCCESS ) && ( i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES ); i++ )
+        {
+            /* Create the result queue of each DNS query slot. */
+            cellularBg770Context.dnsQueries[ i ].resultQueue = xQueueCreate( 1, sizeof( cellularDnsQueryCompletion_t ) );
+
+            if( cellularBg770Context.dnsQueries[ i ].resultQueue == NULL )
             {
                 cellularStatus = CELLULAR_NO_MEMORY;
             }
@@ -508,6 +570,174 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
                                                        ( ( PlatformEventGroup_EventBits ) INIT_EVT_MASK_ALL_EVENTS ) );
             }
         }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the AT request priority lanes. */
+            atPriorityMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.atPriorityMutex, false );
+
+            if( atPriorityMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularBg770Context.pAtPriorityEvent = ( PlatformEventGroupHandle_t ) PlatformEventGroup_Create();
+
+            if( cellularBg770Context.pAtPriorityEvent == NULL )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the DNS result cache. */
+            dnsCacheMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.dnsCacheMutex, false );
+
+            if( dnsCacheMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the SIM and modem identity cache. */
+            identityCacheMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.identityCacheMutex, false );
+
+            if( identityCacheMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the serving cell cache. */
+            servingCellMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.servingCellMutex, false );
+
+            if( servingCellMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the signal history. */
+            signalHistoryMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.signalHistoryMutex, false );
+
+            if( signalHistoryMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the PSM timeline. */
+            psmMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.psmMutex, false );
+
+            if( psmMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the deferred sends. */
+            deferredSendMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.deferredSendMutex, false );
+
+            if( deferredSendMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the automatic PSM entry, its thread is started on first use. */
+            autoPsmMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.autoPsmMutex, false );
+
+            if( autoPsmMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the eDRX parameters. */
+            edrxMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.edrxMutex, false );
+
+            if( edrxMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the health monitor, its thread is started on first use. */
+            healthMonitorMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.healthMonitorMutex, false );
+
+            if( healthMonitorMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the thermal governor. */
+            thermalMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.thermalMutex, false );
+
+            if( thermalMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+            else
+            {
+                cellularBg770Context.thermalStats.lastTemperatureCelsius = CELLULAR_INVALID_SIGNAL_VALUE;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for adaptive send chunking. */
+            adaptiveChunkMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.adaptiveChunkMutex, false );
+
+            if( adaptiveChunkMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+            else
+            {
+                cellularBg770Context.adaptiveChunkStats.rsrp = CELLULAR_INVALID_SIGNAL_VALUE;
+                cellularBg770Context.adaptiveChunkStats.sinr = CELLULAR_INVALID_SIGNAL_VALUE;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Create the mutex for the URC dispatch statistics and socket generations. */
+            urcDispatchMutexCreateStatus = PlatformMutex_Create( &cellularBg770Context.urcDispatchMutex, false );
+
+            if( urcDispatchMutexCreateStatus == false )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Created last, it releases its own resources on failure. */
+            cellularStatus = _Cellular_UrcDispatchInit( pContext, &cellularBg770Context );
+        }
     }
 
     if (cellularStatus == CELLULAR_SUCCESS)
@@ -523,10 +753,19 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
             PlatformMutex_Destroy( &cellularBg770Context.dnsQueryMutex );
         }
 
-        if( cellularBg770Context.pktDnsQueue != NULL )
+        if( dnsPendingMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.dnsPendingMutex );
+        }
+
+        for( i = 0; i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES; i++ )
         {
-            /* Delete DNS queue. */
-            vQueueDelete( cellularBg770Context.pktDnsQueue );
+            if( cellularBg770Context.dnsQueries[ i ].resultQueue != NULL )
+            {
+                /* Delete DNS queue. */
+                vQueueDelete( cellularBg770Context.dnsQueries[ i ].resultQueue );
+                cellularBg770Context.dnsQueries[ i ].resultQueue = NULL;
+            }
         }
 
         if (cellularBg770Context.pInitEvent != NULL)
@@ -534,6 +773,77 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
             ( void ) PlatformEventGroup_Delete( cellularBg770Context.pInitEvent );
             cellularBg770Context.pInitEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
         }
+
+        if( atPriorityMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.atPriorityMutex );
+        }
+
+        if( cellularBg770Context.pAtPriorityEvent != NULL )
+        {
+            ( void ) PlatformEventGroup_Delete( cellularBg770Context.pAtPriorityEvent );
+            cellularBg770Context.pAtPriorityEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+        }
+
+        if( dnsCacheMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.dnsCacheMutex );
+        }
+
+        if( identityCacheMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.identityCacheMutex );
+        }
+
+        if( servingCellMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.servingCellMutex );
+        }
+
+        if( signalHistoryMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.signalHistoryMutex );
+        }
+
+        if( psmMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.psmMutex );
+        }
+
+        if( deferredSendMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.deferredSendMutex );
+        }
+
+        if( autoPsmMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.autoPsmMutex );
+        }
+
+        if( edrxMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.edrxMutex );
+        }
+
+        if( healthMonitorMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.healthMonitorMutex );
+        }
+
+        if( thermalMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.thermalMutex );
+        }
+
+        if( adaptiveChunkMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.adaptiveChunkMutex );
+        }
+
+        if( urcDispatchMutexCreateStatus )
+        {
+            PlatformMutex_Destroy( &cellularBg770Context.urcDispatchMutex );
+        }
     }
 
     return cellularStatus;
@@ -546,6 +856,7 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
 CellularError_t Cellular_ModuleCleanUp( const CellularContext_t * pContext )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t i = 0;
 
     if( pContext == NULL )
     {
@@ -553,15 +864,67 @@ CellularError_t Cellular_ModuleCleanUp( const CellularContext_t * pContext )
     }
     else
     {
-        /* Delete DNS queue. */
-        vQueueDelete( cellularBg770Context.pktDnsQueue );
-        cellularBg770Context.pktDnsQueue = NULL;
+        /* Stop the threads first, they may still use the resources below. Releasing the lanes keeps
+         * them from waiting there behind requests that will not come. */
+        _atPriorityClose( &cellularBg770Context );
+        _healthMonitorStop( &cellularBg770Context );
+        _autoPsmStop( &cellularBg770Context );
+        _Cellular_UrcDispatchCleanUp( &cellularBg770Context );
 
-        /* Delete the mutex for DNS. */
+        /* Delete DNS queues. */
+        for( i = 0; i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES; i++ )
+        {
+            vQueueDelete( cellularBg770Context.dnsQueries[ i ].resultQueue );
+            cellularBg770Context.dnsQueries[ i ].resultQueue = NULL;
+        }
+
+        /* Delete the mutexes for DNS. */
         PlatformMutex_Destroy( &cellularBg770Context.dnsQueryMutex );
+        PlatformMutex_Destroy( &cellularBg770Context.dnsPendingMutex );
 
         ( void ) PlatformEventGroup_Delete( cellularBg770Context.pInitEvent );
         cellularBg770Context.pInitEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+
+        /* Delete the AT request priority lanes. */
+        ( void ) PlatformEventGroup_Delete( cellularBg770Context.pAtPriorityEvent );
+        cellularBg770Context.pAtPriorityEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+        PlatformMutex_Destroy( &cellularBg770Context.atPriorityMutex );
+
+        /* Delete the mutex for the DNS result cache. */
+        PlatformMutex_Destroy( &cellularBg770Context.dnsCacheMutex );
+
+        /* Delete the mutex for the identity cache. */
+        PlatformMutex_Destroy( &cellularBg770Context.identityCacheMutex );
+
+        /* Delete the mutex for the serving cell cache. */
+        PlatformMutex_Destroy( &cellularBg770Context.servingCellMutex );
+
+        /* Delete the mutex for the signal history. */
+        PlatformMutex_Destroy( &cellularBg770Context.signalHistoryMutex );
+
+        /* Delete the mutex for the PSM timeline. */
+        PlatformMutex_Destroy( &cellularBg770Context.psmMutex );
+
+        /* Delete the mutex for the deferred sends. */
+        PlatformMutex_Destroy( &cellularBg770Context.deferredSendMutex );
+
+        /* Delete the mutex for the automatic PSM entry. */
+        PlatformMutex_Destroy( &cellularBg770Context.autoPsmMutex );
+
+        /* Delete the mutex for the eDRX parameters. */
+        PlatformMutex_Destroy( &cellularBg770Context.edrxMutex );
+
+        /* Delete the mutex for the health monitor. */
+        PlatformMutex_Destroy( &cellularBg770Context.healthMonitorMutex );
+
+        /* Delete the mutex for the thermal governor. */
+        PlatformMutex_Destroy( &cellularBg770Context.thermalMutex );
+
+        /* Delete the mutex for adaptive send chunking. */
+        PlatformMutex_Destroy( &cellularBg770Context.adaptiveChunkMutex );
+
+        /* Delete the mutex for the URC dispatch, the worker has stopped. */
+        PlatformMutex_Destroy( &cellularBg770Context.urcDispatchMutex );
     }
 
     return cellularStatus;
@@ -602,11 +965,10 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
         if( ( result == CELLULAR_SUCCESS ) && ( pModuleContext != NULL ) )
         {
             /* Wait events for abort thread or rx data available. */
-            PlatformEventGroup_EventBits uxBits = ( PlatformEventGroup_EventBits ) PlatformEventGroup_WaitBits(
+            PlatformEventGroup_EventBits uxBits = _Cellular_WaitBits(
                     ( PlatformEventGroupHandle_t ) pModuleContext->pInitEvent,
                     ( ( PlatformEventGroup_EventBits ) INIT_EVT_MASK_APP_RDY_RECEIVED ),
                     pdTRUE,
-                    pdFALSE,
                     APP_READY_MAX_WAIT_PERIOD_ticks );
 
             if( ( uxBits & INIT_EVT_MASK_APP_RDY_RECEIVED ) != 0 )
@@ -621,10 +983,10 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
         else
         {
             LogError( ( "Cellular_ModuleEnableUE: Failed to wait on Init event flag 'APP_RDY received', waiting %lu ticks.", APP_READY_MAX_WAIT_PERIOD_ticks ) );
-            vTaskDelay( APP_READY_MAX_WAIT_PERIOD_ticks );
+            _Cellular_DelayTicks( APP_READY_MAX_WAIT_PERIOD_ticks );
         }
 
-        vTaskDelay( POST_APP_READY_WAIT_PERIOD_ticks );
+        _Cellular_DelayTicks( POST_APP_READY_WAIT_PERIOD_ticks );
 
         /* Empty command, looking for 'OK' to indicate presence of module. */
         atReqGetWithResult.pAtCmd = "AT";
@@ -674,7 +1036,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 #ifndef CELLULAR_CONFIG_DISABLE_FLOW_CONTROL
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             static const BG770FlowControlState_t desiredFlowControlState =
             {
@@ -738,7 +1100,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             /* NOTE: Command may fail the first time a new different SIM card is inserted (eg. Soracom -> Verizon or Verizon -> Soracom),
              *       therefore, it is important that Cellular_Init() be tried more than once. */
@@ -781,7 +1143,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             BG770URCIndicationOptionType_t urcIndicationOptionType = BG770_URC_INDICATION_OPTION_UNKNOWN;
             CellularError_t getURCIndicationOptionStatus = _GetURCIndicationOptionWithRetryTimeout(
@@ -824,7 +1186,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 #if defined(CELLULAR_QUECTEL_ENABLE_DEBUG_UART) || defined(CELLULAR_QUECTEL_DISABLE_DEBUG_UART)
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             /* Setting debug output enable. */
 #ifdef CELLULAR_QUECTEL_ENABLE_DEBUG_UART
@@ -854,7 +1216,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 #if defined(CELLULAR_QUECTEL_ENABLE_USB) || defined(CELLULAR_QUECTEL_DISABLE_USB)
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             /* Setting debug output enable. */
 #ifdef CELLULAR_QUECTEL_ENABLE_USB
@@ -881,7 +1243,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             BG770NetworkCategorySearchMode_t networkCategorySearchMode = BG770_NETWORK_CATEGORY_SEARCH_MODE_UNKNOWN;
             cellularStatus = _GetNetworkCategorySearchModeWithRetryTimeout(
@@ -924,7 +1286,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             BG770RATScanSequence_t currentRATScanSequence = UNKNOWN_RAT_SCAN_SEQUENCE;
             cellularStatus = _GetRATScanSequenceWithRetryTimeout(
@@ -996,7 +1358,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            vTaskDelay( SHORT_DELAY_ticks );
+            _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
             /* Disable LwM2M (automatically turned on with Verizon SIM, LwM2M can change APN and mess with normal DNS lookups) */
             /* MISRA Ref 21.6.1 [Use of snprintf] */
@@ -1010,7 +1372,7 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
             CellularError_t getLwM2MEnableStatus = _GetLwM2MEnabled(pContext, &isLwM2MEnabled );
             if( getLwM2MEnableStatus != CELLULAR_SUCCESS || isLwM2MEnabled )
             {
-                vTaskDelay( SHORT_DELAY_ticks );
+                _Cellular_DelayTicks( SHORT_DELAY_ticks );
 
                 cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
                 if( cellularStatus == CELLULAR_SUCCESS )
@@ -1082,9 +1444,12 @@ CellularError_t Cellular_ModuleEnableUrc( CellularContext_t * pContext )
     atReqGetNoResult.pAtCmd = "AT+CTZR=1";
     ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
 
-    /* Disable PSM URC reporting by unsolicited result code +QPSMTIMER: <TAU_timer>,<T3324_timer> */
-    /* FUTURE: Enable (1) when PSM used */
+    /* Configure PSM URC reporting by unsolicited result code +QPSMTIMER: <TAU_timer>,<T3324_timer> */
+#ifdef CELLULAR_BG770_PSM_TIMER_URC
+    atReqGetNoResult.pAtCmd = "AT+QCFG=\"psm/urc\",1";
+#else
     atReqGetNoResult.pAtCmd = "AT+QCFG=\"psm/urc\",0";
+#endif /* CELLULAR_BG770_PSM_TIMER_URC */
     ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
 
     return cellularStatus;
@@ -1409,7 +1774,7 @@ static CellularError_t _GetURCIndicationOptionWithRetryTimeout( CellularHandle_t
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             cellularStatus = _GetURCIndicationOption( cellularHandle, pURCIndicationOptionType, commandTimeoutMS );
@@ -1538,6 +1903,1777 @@ CellularError_t CellularModule_TryGetDidSkipInitializationPostHWFlowControlSetup
 
 /*-----------------------------------------------------------*/
 
+/* A class may proceed only when no prioritized request is in flight and no higher class is queued. */
+static bool _isAtPriorityBlocked( const cellularModuleContext_t * pModuleContext,
+                                  CellularAtPriorityClass_t priorityClass )
+{
+    bool blocked = pModuleContext->atPriorityBusy;
+    uint32_t i = 0;
+
+    for( i = 0; ( blocked == false ) && ( i < ( uint32_t ) priorityClass ); i++ )
+    {
+        if( pModuleContext->atPriorityWaiting[ i ] > 0U )
+        {
+            blocked = true;
+        }
+    }
+
+    /* While the module is cleaned up nothing waits, the requests fail on the closed interface instead. */
+    if( pModuleContext->atPriorityClosing )
+    {
+        blocked = false;
+    }
+
+    return blocked;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with atPriorityMutex held on a free lane. Wakes the waiters of the highest queued class, they are
+ * the only ones that may proceed. Waiters are never woken otherwise, so every path that frees the lane or
+ * leaves the queue must come here. */
+static void _atPriorityWakeNext( cellularModuleContext_t * pModuleContext,
+                                 bool countPreempted )
+{
+    uint32_t nextClass = ( uint32_t ) CELLULAR_AT_PRIORITY_MAX;
+    uint32_t i = 0;
+
+    for( i = 0; i < ( uint32_t ) CELLULAR_AT_PRIORITY_MAX; i++ )
+    {
+        if( pModuleContext->atPriorityWaiting[ i ] > 0U )
+        {
+            if( nextClass == ( uint32_t ) CELLULAR_AT_PRIORITY_MAX )
+            {
+                nextClass = i;
+            }
+            else if( countPreempted )
+            {
+                /* A lower class is passed over in favour of nextClass. */
+                pModuleContext->atPriorityStats[ i ].preemptedCount++;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
+    }
+
+    if( nextClass != ( uint32_t ) CELLULAR_AT_PRIORITY_MAX )
+    {
+        ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAtPriorityEvent,
+                                             AT_PRIORITY_EVENT_BIT( nextClass ) );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void _atPriorityClose( cellularModuleContext_t * pModuleContext )
+{
+    PlatformEventGroup_EventBits allClassBits = 0;
+    uint32_t i = 0;
+
+    if( pModuleContext->pAtPriorityEvent != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->atPriorityMutex );
+        pModuleContext->atPriorityClosing = true;
+        PlatformMutex_Unlock( &pModuleContext->atPriorityMutex );
+
+        for( i = 0; i < ( uint32_t ) CELLULAR_AT_PRIORITY_MAX; i++ )
+        {
+            allClassBits |= AT_PRIORITY_EVENT_BIT( i );
+        }
+
+        ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAtPriorityEvent,
+                                             allClassBits );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* A NULL deadline waits as long as the lane is taken. An expired deadline fails with CELLULAR_TIMEOUT and
+ * *pAcquired false. Without lanes the request still goes out, with CELLULAR_SUCCESS and *pAcquired false. */
+CellularError_t _Cellular_AtPriorityAcquire( const CellularContext_t * pContext,
+                                             CellularAtPriorityClass_t priorityClass,
+                                             const TickType_t * pDeadlineTicks,
+                                             bool * pAcquired )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularAtPriorityStats_t * pStats = NULL;
+    const TickType_t enqueueTicks = _Cellular_GetTicks();
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t remainingTicks = 0;
+    uint32_t queueDelayMs = 0;
+
+    *pAcquired = false;
+
+    if( ( priorityClass >= CELLULAR_AT_PRIORITY_MAX ) ||
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) != CELLULAR_SUCCESS ) ||
+        ( pModuleContext == NULL ) || ( pModuleContext->pAtPriorityEvent == NULL ) )
+    {
+        /* No lanes, the request still goes through the common library's own serialization. */
+        LogDebug( ( "_Cellular_AtPriorityAcquire: priority lanes unavailable, class: %d", priorityClass ) );
+    }
+    else
+    {
+        PlatformMutex_Lock( &pModuleContext->atPriorityMutex );
+        pModuleContext->atPriorityWaiting[ priorityClass ]++;
+
+        while( ( cellularStatus == CELLULAR_SUCCESS ) && ( _isAtPriorityBlocked( pModuleContext, priorityClass ) ) )
+        {
+            if( pDeadlineTicks != NULL )
+            {
+                /* Same wrap rule as the AT timeouts, more than half the tick range away has passed. */
+                remainingTicks = *pDeadlineTicks - _Cellular_GetTicks();
+
+                if( ( remainingTicks == 0U ) || ( remainingTicks > ( portMAX_DELAY / 2U ) ) )
+                {
+                    cellularStatus = CELLULAR_TIMEOUT;
+                }
+                else
+                {
+                    waitTicks = remainingTicks;
+                }
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Unlock( &pModuleContext->atPriorityMutex );
+                ( void ) _Cellular_WaitBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAtPriorityEvent,
+                                             AT_PRIORITY_EVENT_BIT( priorityClass ),
+                                             pdTRUE,
+                                             waitTicks );
+                PlatformMutex_Lock( &pModuleContext->atPriorityMutex );
+            }
+        }
+
+        pModuleContext->atPriorityWaiting[ priorityClass ]--;
+
+        if( cellularStatus == CELLULAR_TIMEOUT )
+        {
+            pModuleContext->atPriorityStats[ priorityClass ].timedOutCount++;
+
+            /* This waiter may have held back lower classes, or taken the wake meant for its class. */
+            if( pModuleContext->atPriorityBusy == false )
+            {
+                _atPriorityWakeNext( pModuleContext, false );
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->atPriorityMutex );
+            LogWarn( ( "_Cellular_AtPriorityAcquire: deadline expired while queued, class: %d", priorityClass ) );
+        }
+        else
+        {
+            pModuleContext->atPriorityBusy = true;
+            pModuleContext->atPriorityBusyClass = priorityClass;
+
+            if( priorityClass == CELLULAR_AT_PRIORITY_DATA )
+            {
+                pModuleContext->dataRequestSeen = true;
+                pModuleContext->lastDataRequestTicks = _Cellular_GetTicks();
+            }
+
+            queueDelayMs = ( uint32_t ) ( ( ( uint64_t ) ( _Cellular_GetTicks() - enqueueTicks ) * 1000U ) /
+                                          ( uint64_t ) configTICK_RATE_HZ );
+            pStats = &pModuleContext->atPriorityStats[ priorityClass ];
+            pStats->requestCount++;
+            pStats->lastQueueDelayMs = queueDelayMs;
+            pStats->totalQueueDelayMs += queueDelayMs;
+
+            if( queueDelayMs > pStats->maxQueueDelayMs )
+            {
+                pStats->maxQueueDelayMs = queueDelayMs;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->atPriorityMutex );
+            *pAcquired = true;
+
+            _autoPsmAtActivity( pModuleContext, true );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_AtPriorityRelease( const CellularContext_t * pContext )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) &&
+        ( pModuleContext != NULL ) && ( pModuleContext->pAtPriorityEvent != NULL ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->atPriorityMutex );
+        pModuleContext->atPriorityBusy = false;
+
+        if( pModuleContext->atPriorityBusyClass == CELLULAR_AT_PRIORITY_DATA )
+        {
+            pModuleContext->lastDataRequestTicks = _Cellular_GetTicks();
+        }
+
+        _atPriorityWakeNext( pModuleContext, true );
+        PlatformMutex_Unlock( &pModuleContext->atPriorityMutex );
+
+        _autoPsmAtActivity( pModuleContext, false );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+bool _Cellular_IsDataTransferActive( cellularModuleContext_t * pModuleContext )
+{
+    bool active = false;
+
+    PlatformMutex_Lock( &pModuleContext->atPriorityMutex );
+
+    if( ( pModuleContext->atPriorityBusy ) && ( pModuleContext->atPriorityBusyClass == CELLULAR_AT_PRIORITY_DATA ) )
+    {
+        active = true;
+    }
+    else if( pModuleContext->dataRequestSeen )
+    {
+        active = ( ( _Cellular_GetTicks() - pModuleContext->lastDataRequestTicks ) <
+                   pdMS_TO_TICKS( CELLULAR_BG770_DATA_TRANSFER_QUIET_MS ) );
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    /* Waiting data requests are about to run. */
+    active = ( active ) || ( pModuleContext->atPriorityWaiting[ CELLULAR_AT_PRIORITY_DATA ] > 0U );
+    PlatformMutex_Unlock( &pModuleContext->atPriorityMutex );
+
+    return active;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _autoPsmAtActivity( cellularModuleContext_t * pModuleContext,
+                                bool begin )
+{
+    PlatformMutex_Lock( &pModuleContext->autoPsmMutex );
+
+    if( begin )
+    {
+        pModuleContext->activeAtRequests++;
+    }
+    else if( pModuleContext->activeAtRequests > 0U )
+    {
+        pModuleContext->activeAtRequests--;
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    pModuleContext->lastActivityTicks = _Cellular_GetTicks();
+    pModuleContext->autoPsmRequested = false;
+    PlatformMutex_Unlock( &pModuleContext->autoPsmMutex );
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_IdleTrackerUpdate( const CellularContext_t * pContext,
+                                  cellularIdleActivity_t activity,
+                                  uint32_t socketId )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    const uint32_t socketBit = ( socketId < 32U ) ? ( 1UL << socketId ) : 0U;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->autoPsmMutex );
+
+        if( activity == CELLULAR_IDLE_ACTIVITY_RECV_PENDING )
+        {
+            pModuleContext->pendingRecvSocketMask |= socketBit;
+            pModuleContext->lastActivityTicks = _Cellular_GetTicks();
+            pModuleContext->autoPsmRequested = false;
+        }
+        else
+        {
+            pModuleContext->pendingRecvSocketMask &= ~socketBit;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->autoPsmMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Entry is only worth asking for when the network granted PSM and the modem is awake. Seeing the modem in
+ * PSM means the last request was served, the next wake up needs a new one. */
+static bool _isAutoPsmEntryDue( cellularModuleContext_t * pModuleContext )
+{
+    bool due = false;
+    bool psmNegotiated = false;
+    bool inPsm = false;
+    const TickType_t nowTicks = _Cellular_GetTicks();
+
+    PlatformMutex_Lock( &pModuleContext->psmMutex );
+    psmNegotiated = ( pModuleContext->psmTimeline.timersKnown ) &&
+                    ( pModuleContext->psmTimeline.periodicTauSeconds != 0U );
+    inPsm = pModuleContext->psmTimeline.inPsm;
+    PlatformMutex_Unlock( &pModuleContext->psmMutex );
+
+    PlatformMutex_Lock( &pModuleContext->autoPsmMutex );
+
+    if( inPsm )
+    {
+        pModuleContext->autoPsmRequested = false;
+    }
+    else if( ( psmNegotiated ) &&
+             ( pModuleContext->autoPsmIdleTimeoutMs != 0U ) &&
+             ( pModuleContext->autoPsmRequested == false ) &&
+             ( pModuleContext->activeAtRequests == 0U ) &&
+             ( ( nowTicks - pModuleContext->lastActivityTicks ) >= pdMS_TO_TICKS( pModuleContext->autoPsmIdleTimeoutMs ) ) )
+    {
+        if( pModuleContext->pendingRecvSocketMask != 0U )
+        {
+            pModuleContext->autoPsmStats.pendingRecvBlockCount++;
+        }
+        else
+        {
+            due = true;
+        }
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    PlatformMutex_Unlock( &pModuleContext->autoPsmMutex );
+
+    return due;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _autoPsmThread( void * pArgument )
+{
+    cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pArgument;
+    PlatformEventGroup_EventBits uxBits = 0;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    bool running = true;
+
+    while( running )
+    {
+        uxBits = _Cellular_WaitBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAutoPsmEvent,
+                                     ( PlatformEventGroup_EventBits ) AUTO_PSM_EVT_MASK_STOP,
+                                     pdTRUE,
+                                     pdMS_TO_TICKS( CELLULAR_BG770_AUTO_PSM_CHECK_INTERVAL_MS ) );
+
+        if( ( uxBits & AUTO_PSM_EVT_MASK_STOP ) != 0U )
+        {
+            running = false;
+        }
+        else if( _isAutoPsmEntryDue( pModuleContext ) )
+        {
+            LogDebug( ( "_autoPsmThread: Modem idle, requesting PSM entry" ) );
+            cellularStatus = Cellular_SetPSMEntry( ( CellularHandle_t ) pModuleContext->pAutoPsmContext,
+                                                   CELLULAR_PSM_ENTER_MODE_IMMEDIATE );
+
+            /* The request itself counted as activity, a failed one is retried after another idle period. */
+            PlatformMutex_Lock( &pModuleContext->autoPsmMutex );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                pModuleContext->autoPsmRequested = true;
+                pModuleContext->autoPsmStats.entryRequestCount++;
+            }
+            else
+            {
+                pModuleContext->autoPsmStats.entryFailureCount++;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->autoPsmMutex );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+    ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAutoPsmEvent,
+                                         ( PlatformEventGroup_EventBits ) AUTO_PSM_EVT_MASK_STOPPED );
+}
+
+/*-----------------------------------------------------------*/
+
+static void _autoPsmStop( cellularModuleContext_t * pModuleContext )
+{
+    PlatformEventGroup_EventBits uxBits = 0;
+
+    if( pModuleContext->pAutoPsmEvent != NULL )
+    {
+        ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAutoPsmEvent,
+                                             ( PlatformEventGroup_EventBits ) AUTO_PSM_EVT_MASK_STOP );
+
+        /* The thread uses the mutexes and lanes the caller deletes next, it is joined whatever it takes.
+         * Its PSM entry request is bounded by the command timeout. */
+        while( ( uxBits & AUTO_PSM_EVT_MASK_STOPPED ) == 0U )
+        {
+            uxBits = _Cellular_WaitBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAutoPsmEvent,
+                                         ( PlatformEventGroup_EventBits ) AUTO_PSM_EVT_MASK_STOPPED,
+                                         pdTRUE,
+                                         AUTO_PSM_STOP_TIMEOUT_ticks );
+
+            if( ( uxBits & AUTO_PSM_EVT_MASK_STOPPED ) == 0U )
+            {
+                LogWarn( ( "_autoPsmStop: Still waiting for the idle monitor thread to stop" ) );
+            }
+        }
+
+        ( void ) PlatformEventGroup_Delete( pModuleContext->pAutoPsmEvent );
+        pModuleContext->pAutoPsmEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Looks at the STOP bit without taking it, the thread loop still sees it. */
+static bool _healthMonitorStopRequested( const cellularModuleContext_t * pModuleContext )
+{
+    PlatformEventGroup_EventBits uxBits = _Cellular_WaitBits(
+            ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+            ( PlatformEventGroup_EventBits ) HEALTH_MONITOR_EVT_MASK_STOP,
+            pdFALSE,
+            ( TickType_t ) 0 );
+
+    return ( ( uxBits & HEALTH_MONITOR_EVT_MASK_STOP ) != 0U ) ? true : false;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Each part keeps its previous value when its query fails, validMask tells which ones are fresh.
+ * A stop request abandons the pass between queries, the snapshot is then left as it was. */
+static void _healthMonitorSample( cellularModuleContext_t * pModuleContext )
+{
+    CellularHandle_t cellularHandle = ( CellularHandle_t ) pModuleContext->pHealthMonitorContext;
+    CellularHealthSnapshot_t snapshot;
+    bool inPsm = false;
+    bool dataActive = false;
+    bool stopped = false;
+
+    PlatformMutex_Lock( &pModuleContext->psmMutex );
+    inPsm = pModuleContext->psmTimeline.inPsm;
+    PlatformMutex_Unlock( &pModuleContext->psmMutex );
+
+    dataActive = _Cellular_IsDataTransferActive( pModuleContext );
+
+    PlatformMutex_Lock( &pModuleContext->healthMonitorMutex );
+    snapshot = pModuleContext->healthSnapshot;
+
+    if( inPsm )
+    {
+        pModuleContext->healthSnapshot.skippedInPsmCount++;
+    }
+    else if( dataActive )
+    {
+        pModuleContext->healthSnapshot.skippedForDataCount++;
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    PlatformMutex_Unlock( &pModuleContext->healthMonitorMutex );
+
+    if( ( inPsm == false ) && ( dataActive == false ) )
+    {
+        snapshot.validMask = 0;
+
+        if( Cellular_GetSignalInfoSkipRatQuery( cellularHandle, &snapshot.signalInfo ) == CELLULAR_SUCCESS )
+        {
+            snapshot.validMask |= CELLULAR_HEALTH_VALID_SIGNAL_INFO;
+        }
+
+        if( _healthMonitorStopRequested( pModuleContext ) )
+        {
+            stopped = true;
+        }
+        else if( Cellular_GetModemTemperatures( cellularHandle, &snapshot.temperatures ) == CELLULAR_SUCCESS )
+        {
+            snapshot.validMask |= CELLULAR_HEALTH_VALID_TEMPERATURES;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+
+        if( stopped || _healthMonitorStopRequested( pModuleContext ) )
+        {
+            stopped = true;
+        }
+        else if( Cellular_GetLTENetworkInfo( cellularHandle, &snapshot.lteNetworkInfo ) == CELLULAR_SUCCESS )
+        {
+            snapshot.validMask |= CELLULAR_HEALTH_VALID_LTE_NETWORK_INFO;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+
+        if( stopped || _healthMonitorStopRequested( pModuleContext ) )
+        {
+            stopped = true;
+        }
+        else if( Cellular_GetServiceStatus( cellularHandle, &snapshot.serviceStatus ) == CELLULAR_SUCCESS )
+        {
+            snapshot.validMask |= CELLULAR_HEALTH_VALID_SERVICE_STATUS;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+    if( stopped )
+    {
+        LogDebug( ( "_healthMonitorSample: stop requested, pass abandoned" ) );
+    }
+    else if( ( inPsm == false ) && ( dataActive == false ) )
+    {
+        /* The skip counters may have moved during the pass, they are not taken from the local copy. */
+        PlatformMutex_Lock( &pModuleContext->healthMonitorMutex );
+        snapshot.version = CELLULAR_HEALTH_SNAPSHOT_VERSION;
+        snapshot.sequence = pModuleContext->healthSnapshot.sequence + 1U;
+        snapshot.sampledTicks = _Cellular_GetTicks();
+        snapshot.skippedInPsmCount = pModuleContext->healthSnapshot.skippedInPsmCount;
+        snapshot.skippedForDataCount = pModuleContext->healthSnapshot.skippedForDataCount;
+        pModuleContext->healthSnapshot = snapshot;
+        PlatformMutex_Unlock( &pModuleContext->healthMonitorMutex );
+
+        LogDebug( ( "_healthMonitorSample: snapshot %lu, valid 0x%lx", snapshot.sequence, snapshot.validMask ) );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void _healthMonitorThread( void * pArgument )
+{
+    cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pArgument;
+    PlatformEventGroup_EventBits uxBits = 0;
+    TickType_t waitTicks = 0;
+    uint32_t periodMs = 0;
+    bool running = true;
+
+    while( running )
+    {
+        PlatformMutex_Lock( &pModuleContext->healthMonitorMutex );
+        periodMs = pModuleContext->healthMonitorPeriodMs;
+        PlatformMutex_Unlock( &pModuleContext->healthMonitorMutex );
+
+        /* A paused monitor sleeps until the period is set again. */
+        waitTicks = ( periodMs == 0U ) ? portMAX_DELAY : pdMS_TO_TICKS( periodMs );
+        uxBits = _Cellular_WaitBits( ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+                                     ( PlatformEventGroup_EventBits ) ( HEALTH_MONITOR_EVT_MASK_STOP | HEALTH_MONITOR_EVT_MASK_WAKE ),
+                                     pdTRUE,
+                                     waitTicks );
+
+        if( ( uxBits & HEALTH_MONITOR_EVT_MASK_STOP ) != 0U )
+        {
+            running = false;
+        }
+        else if( ( uxBits & HEALTH_MONITOR_EVT_MASK_WAKE ) != 0U )
+        {
+            /* The period changed, start a new wait with it. */
+        }
+        else
+        {
+            _healthMonitorSample( pModuleContext );
+        }
+    }
+
+    ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+                                         ( PlatformEventGroup_EventBits ) HEALTH_MONITOR_EVT_MASK_STOPPED );
+}
+
+/*-----------------------------------------------------------*/
+
+static void _healthMonitorStop( cellularModuleContext_t * pModuleContext )
+{
+    PlatformEventGroup_EventBits uxBits = 0;
+
+    if( pModuleContext->pHealthMonitorEvent != NULL )
+    {
+        ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+                                             ( PlatformEventGroup_EventBits ) HEALTH_MONITOR_EVT_MASK_STOP );
+
+        /* The thread uses the mutexes and lanes the caller deletes next, it is joined whatever it takes.
+         * A pass in progress gives up at its next query. */
+        while( ( uxBits & HEALTH_MONITOR_EVT_MASK_STOPPED ) == 0U )
+        {
+            uxBits = _Cellular_WaitBits( ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+                                         ( PlatformEventGroup_EventBits ) HEALTH_MONITOR_EVT_MASK_STOPPED,
+                                         pdTRUE,
+                                         HEALTH_MONITOR_STOP_TIMEOUT_ticks );
+
+            if( ( uxBits & HEALTH_MONITOR_EVT_MASK_STOPPED ) == 0U )
+            {
+                LogWarn( ( "_healthMonitorStop: Still waiting for the health monitor thread to stop" ) );
+            }
+        }
+
+        ( void ) PlatformEventGroup_Delete( pModuleContext->pHealthMonitorEvent );
+        pModuleContext->pHealthMonitorEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetAtPriorityStats( CellularAtPriorityClass_t priorityClass,
+                                                   CellularAtPriorityStats_t *const pStats )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( ( pStats == NULL ) || ( priorityClass >= CELLULAR_AT_PRIORITY_MAX ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pAtPriorityEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.atPriorityMutex );
+        *pStats = cellularBg770Context.atPriorityStats[ priorityClass ];
+        PlatformMutex_Unlock( &cellularBg770Context.atPriorityMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_ResetAtPriorityStats( void )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( cellularBg770Context.pAtPriorityEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.atPriorityMutex );
+        ( void ) memset( cellularBg770Context.atPriorityStats, 0, sizeof( cellularBg770Context.atPriorityStats ) );
+        PlatformMutex_Unlock( &cellularBg770Context.atPriorityMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetUrcDispatchStats( CellularUrcDispatchStats_t * pStats )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.urcDispatchMutex );
+        *pStats = cellularBg770Context.urcDispatchStats;
+        PlatformMutex_Unlock( &cellularBg770Context.urcDispatchMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Must be called with dnsCacheMutex held. */
+static cellularDnsCacheEntry_t * _findDnsCacheEntry( cellularModuleContext_t * pModuleContext,
+                                                     uint8_t contextId,
+                                                     const char * pHostName )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    uint32_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG770_DNS_CACHE_SIZE; i++ )
+    {
+        if( ( pModuleContext->dnsCache[ i ].valid ) &&
+            ( pModuleContext->dnsCache[ i ].contextId == contextId ) &&
+            ( strcmp( pModuleContext->dnsCache[ i ].hostName, pHostName ) == 0 ) )
+        {
+            pEntry = &pModuleContext->dnsCache[ i ];
+            break;
+        }
+    }
+
+    return pEntry;
+}
+
+/*-----------------------------------------------------------*/
+
+static bool _isDnsCacheEntryExpired( const cellularDnsCacheEntry_t * pEntry,
+                                     TickType_t nowTicks )
+{
+    /* Tick arithmetic wraps, an expiry more than half the tick range away is treated as already passed. */
+    const TickType_t remainingTicks = pEntry->expiryTicks - nowTicks;
+
+    return ( remainingTicks == 0U ) || ( remainingTicks > ( portMAX_DELAY / 2U ) );
+}
+
+/*-----------------------------------------------------------*/
+
+cellularDnsCacheLookupResult_t _Cellular_DnsCacheLookup( cellularModuleContext_t * pModuleContext,
+                                                         uint8_t contextId,
+                                                         const char * pHostName,
+                                                         char * pResolvedAddress,
+                                                         int32_t * pFailureResultCode )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    cellularDnsCacheLookupResult_t lookupResult = CELLULAR_DNS_CACHE_MISS;
+
+    if( ( pModuleContext != NULL ) && ( pHostName != NULL ) && ( pFailureResultCode != NULL ) &&
+        ( ( CELLULAR_BG770_DNS_CACHE_MAX_TTL_SECONDS > 0U ) || ( CELLULAR_BG770_DNS_NEGATIVE_CACHE_SECONDS > 0U ) ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+        pEntry = _findDnsCacheEntry( pModuleContext, contextId, pHostName );
+
+        if( ( pEntry != NULL ) && _isDnsCacheEntryExpired( pEntry, _Cellular_GetTicks() ) )
+        {
+            pEntry->valid = false;
+            pModuleContext->dnsCacheStats.expiredCount++;
+            pEntry = NULL;
+        }
+
+        if( ( pEntry != NULL ) && ( pEntry->negative ) )
+        {
+            *pFailureResultCode = pEntry->failureResultCode;
+            pModuleContext->dnsCacheStats.negativeHitCount++;
+            lookupResult = CELLULAR_DNS_CACHE_NEGATIVE_HIT;
+        }
+        else if( pResolvedAddress == NULL )
+        {
+            /* The caller only checks for a hold-down. */
+        }
+        else if( pEntry != NULL )
+        {
+            ( void ) strncpy( pResolvedAddress, pEntry->address, CELLULAR_IP_ADDRESS_MAX_SIZE );
+            pModuleContext->dnsCacheUseCounter++;
+            pEntry->lastUsed = pModuleContext->dnsCacheUseCounter;
+            pEntry->hitCount++;
+            pModuleContext->dnsCacheStats.hitCount++;
+
+            if( pEntry->refreshed )
+            {
+                pModuleContext->dnsCacheStats.refreshedHitCount++;
+            }
+
+            lookupResult = CELLULAR_DNS_CACHE_HIT;
+        }
+        else
+        {
+            pModuleContext->dnsCacheStats.missCount++;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+    }
+
+    return lookupResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Must be called with dnsCacheMutex held. Returns the entry of the host name if present, otherwise a free or
+ * expired slot, otherwise the least recently used entry. */
+static cellularDnsCacheEntry_t * _allocateDnsCacheEntry( cellularModuleContext_t * pModuleContext,
+                                                         uint8_t contextId,
+                                                         const char * pHostName,
+                                                         TickType_t nowTicks,
+                                                         bool * pNewEntry )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    uint32_t i = 0;
+
+    pEntry = _findDnsCacheEntry( pModuleContext, contextId, pHostName );
+    *pNewEntry = ( pEntry == NULL );
+
+    for( i = 0; ( pEntry == NULL ) && ( i < CELLULAR_BG770_DNS_CACHE_SIZE ); i++ )
+    {
+        if( ( pModuleContext->dnsCache[ i ].valid == false ) ||
+            _isDnsCacheEntryExpired( &pModuleContext->dnsCache[ i ], nowTicks ) )
+        {
+            pEntry = &pModuleContext->dnsCache[ i ];
+        }
+    }
+
+    if( pEntry == NULL )
+    {
+        pEntry = &pModuleContext->dnsCache[ 0 ];
+
+        for( i = 1; i < CELLULAR_BG770_DNS_CACHE_SIZE; i++ )
+        {
+            if( pModuleContext->dnsCache[ i ].lastUsed < pEntry->lastUsed )
+            {
+                pEntry = &pModuleContext->dnsCache[ i ];
+            }
+        }
+
+        LogDebug( ( "_allocateDnsCacheEntry: evicting %s", pEntry->hostName ) );
+        pModuleContext->dnsCacheStats.evictionCount++;
+    }
+
+    if( *pNewEntry )
+    {
+        pEntry->hitCount = 0;
+        pEntry->refreshed = false;
+        ( void ) strncpy( pEntry->hostName, pHostName, CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE );
+        pEntry->hostName[ CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE ] = '\0';
+    }
+
+    pEntry->valid = true;
+    pEntry->contextId = contextId;
+    pModuleContext->dnsCacheUseCounter++;
+    pEntry->lastUsed = pModuleContext->dnsCacheUseCounter;
+
+    return pEntry;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_DnsCacheInsert( cellularModuleContext_t * pModuleContext,
+                               uint8_t contextId,
+                               const char * pHostName,
+                               const char * pResolvedAddress,
+                               uint32_t timeToLiveSeconds )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    const TickType_t nowTicks = _Cellular_GetTicks();
+    uint32_t boundedTimeToLiveSeconds = timeToLiveSeconds;
+    bool newEntry = false;
+
+    if( boundedTimeToLiveSeconds > CELLULAR_BG770_DNS_CACHE_MAX_TTL_SECONDS )
+    {
+        boundedTimeToLiveSeconds = CELLULAR_BG770_DNS_CACHE_MAX_TTL_SECONDS;
+    }
+
+    if( ( pModuleContext == NULL ) || ( pHostName == NULL ) || ( pResolvedAddress == NULL ) ||
+        ( boundedTimeToLiveSeconds == 0U ) || ( strlen( pHostName ) > CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE ) )
+    {
+        LogDebug( ( "_Cellular_DnsCacheInsert: result not cached, ttl: %lu s", timeToLiveSeconds ) );
+    }
+    else
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+        pEntry = _allocateDnsCacheEntry( pModuleContext, contextId, pHostName, nowTicks, &newEntry );
+
+        pEntry->negative = false;
+        pEntry->failureResultCode = 0;
+        pEntry->refreshAttempted = false;
+        pEntry->expiryTicks = nowTicks + ( ( TickType_t ) boundedTimeToLiveSeconds * ( TickType_t ) configTICK_RATE_HZ );
+        ( void ) strncpy( pEntry->address, pResolvedAddress, CELLULAR_IP_ADDRESS_MAX_SIZE );
+        pEntry->address[ CELLULAR_IP_ADDRESS_MAX_SIZE ] = '\0';
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_DnsCacheInsertFailure( cellularModuleContext_t * pModuleContext,
+                                      uint8_t contextId,
+                                      const char * pHostName,
+                                      int32_t failureResultCode )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    const TickType_t nowTicks = _Cellular_GetTicks();
+    bool newEntry = false;
+
+    if( ( pModuleContext == NULL ) || ( pHostName == NULL ) || ( CELLULAR_BG770_DNS_NEGATIVE_CACHE_SECONDS == 0U ) ||
+        ( strlen( pHostName ) > CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE ) )
+    {
+        LogDebug( ( "_Cellular_DnsCacheInsertFailure: failure not held down, result code: %ld", failureResultCode ) );
+    }
+    else
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+        pEntry = _findDnsCacheEntry( pModuleContext, contextId, pHostName );
+
+        /* A result that is still valid is kept, e.g. when a refresh-ahead query fails. */
+        if( ( pEntry != NULL ) && ( pEntry->negative == false ) && ( _isDnsCacheEntryExpired( pEntry, nowTicks ) == false ) )
+        {
+            LogDebug( ( "_Cellular_DnsCacheInsertFailure: %s keeps its cached result", pHostName ) );
+        }
+        else
+        {
+            pEntry = _allocateDnsCacheEntry( pModuleContext, contextId, pHostName, nowTicks, &newEntry );
+
+            pEntry->negative = true;
+            pEntry->failureResultCode = failureResultCode;
+            pEntry->refreshAttempted = true;
+            pEntry->address[ 0 ] = '\0';
+            pEntry->expiryTicks = nowTicks + ( ( TickType_t ) CELLULAR_BG770_DNS_NEGATIVE_CACHE_SECONDS *
+                                               ( TickType_t ) configTICK_RATE_HZ );
+            pModuleContext->dnsCacheStats.negativeInsertCount++;
+            pModuleContext->dnsCacheStats.lastFailureResultCode = failureResultCode;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_DnsCacheInvalidate( cellularModuleContext_t * pModuleContext,
+                                   uint8_t contextId )
+{
+    uint32_t i = 0;
+
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+
+        for( i = 0; i < CELLULAR_BG770_DNS_CACHE_SIZE; i++ )
+        {
+            if( ( pModuleContext->dnsCache[ i ].valid ) && ( pModuleContext->dnsCache[ i ].contextId == contextId ) )
+            {
+                pModuleContext->dnsCache[ i ].valid = false;
+                pModuleContext->dnsCacheStats.invalidationCount++;
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+bool _Cellular_DnsCacheGetRefreshCandidate( cellularModuleContext_t * pModuleContext,
+                                            uint8_t * pContextId,
+                                            char * pHostName )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    const TickType_t nowTicks = _Cellular_GetTicks();
+    const TickType_t refreshWindowTicks = ( TickType_t ) CELLULAR_BG770_DNS_REFRESH_AHEAD_SECONDS *
+                                          ( TickType_t ) configTICK_RATE_HZ;
+    bool candidateFound = false;
+    uint32_t i = 0;
+
+    if( ( pModuleContext != NULL ) && ( pContextId != NULL ) && ( pHostName != NULL ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+
+        for( i = 0; ( candidateFound == false ) && ( i < CELLULAR_BG770_DNS_CACHE_SIZE ); i++ )
+        {
+            pEntry = &pModuleContext->dnsCache[ i ];
+
+            if( ( pEntry->valid ) && ( pEntry->refreshAttempted == false ) &&
+                ( pEntry->hitCount >= CELLULAR_BG770_DNS_REFRESH_AHEAD_MIN_HITS ) &&
+                ( _isDnsCacheEntryExpired( pEntry, nowTicks ) == false ) &&
+                ( ( pEntry->expiryTicks - nowTicks ) <= refreshWindowTicks ) )
+            {
+                pEntry->refreshAttempted = true;
+                *pContextId = pEntry->contextId;
+                ( void ) strncpy( pHostName, pEntry->hostName, CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE );
+                pHostName[ CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE ] = '\0';
+                candidateFound = true;
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+    }
+
+    return candidateFound;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_DnsCacheRefreshDone( cellularModuleContext_t * pModuleContext,
+                                    uint8_t contextId,
+                                    const char * pHostName,
+                                    bool refreshSucceeded )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+
+    if( ( pModuleContext != NULL ) && ( pHostName != NULL ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+
+        if( refreshSucceeded )
+        {
+            pModuleContext->dnsCacheStats.refreshCount++;
+            pEntry = _findDnsCacheEntry( pModuleContext, contextId, pHostName );
+
+            if( pEntry != NULL )
+            {
+                pEntry->refreshed = true;
+            }
+        }
+        else
+        {
+            pModuleContext->dnsCacheStats.refreshFailureCount++;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetDnsCacheStats( CellularDnsCacheStats_t * pStats )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.dnsCacheMutex );
+        *pStats = cellularBg770Context.dnsCacheStats;
+        PlatformMutex_Unlock( &cellularBg770Context.dnsCacheMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_FlushDnsCache( void )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t i = 0;
+
+    if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.dnsCacheMutex );
+
+        for( i = 0; i < CELLULAR_BG770_DNS_CACHE_SIZE; i++ )
+        {
+            if( cellularBg770Context.dnsCache[ i ].valid )
+            {
+                cellularBg770Context.dnsCache[ i ].valid = false;
+                cellularBg770Context.dnsCacheStats.invalidationCount++;
+            }
+        }
+
+        PlatformMutex_Unlock( &cellularBg770Context.dnsCacheMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_IdentityCacheInvalidate( cellularModuleContext_t * pModuleContext,
+                                        bool includeModemInfo )
+{
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+        pModuleContext->identityGeneration++;
+        pModuleContext->simCardInfoValid = false;
+
+        if( includeModemInfo )
+        {
+            /* The QSIMSTAT URC setting may not have survived the restart either. */
+            pModuleContext->modemInfoValid = false;
+            pModuleContext->simStateKnown = false;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_ServingCellInvalidate( cellularModuleContext_t * pModuleContext )
+{
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->servingCellMutex );
+        pModuleContext->servingCellKnown = false;
+        pModuleContext->servingCellInfoValid = false;
+        pModuleContext->servingCellChangeCount++;
+        PlatformMutex_Unlock( &pModuleContext->servingCellMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Must be called with signalHistoryMutex held, or before it is created. */
+static void _resetSignalHistory( cellularModuleContext_t * pModuleContext )
+{
+    ( void ) memset( pModuleContext->signalHistory, 0, sizeof( pModuleContext->signalHistory ) );
+    ( void ) memset( &pModuleContext->signalHistorySummary, 0, sizeof( pModuleContext->signalHistorySummary ) );
+    pModuleContext->signalHistoryNext = 0;
+    pModuleContext->signalHistoryCount = 0;
+    pModuleContext->signalRssiEwmaScaled = 0;
+    pModuleContext->signalHistorySummary.rssiMin = CELLULAR_INVALID_SIGNAL_VALUE;
+    pModuleContext->signalHistorySummary.rssiMax = CELLULAR_INVALID_SIGNAL_VALUE;
+    pModuleContext->signalHistorySummary.rssiEwma = CELLULAR_INVALID_SIGNAL_VALUE;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called from the QIND csq URC handler. */
+void _Cellular_SignalHistoryAdd( cellularModuleContext_t * pModuleContext,
+                                 const CellularSignalInfo_t * pSignalInfo )
+{
+    CellularSignalHistorySummary_t * pSummary = NULL;
+    CellularSignalSample_t * pSample = NULL;
+    const TickType_t nowTicks = _Cellular_GetTicks();
+    const TickType_t minIntervalTicks = pdMS_TO_TICKS( CELLULAR_BG770_SIGNAL_HISTORY_MIN_INTERVAL_MS );
+    uint8_t lastIndex = 0;
+
+    if( ( pModuleContext != NULL ) && ( pSignalInfo != NULL ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->signalHistoryMutex );
+        pSummary = &pModuleContext->signalHistorySummary;
+        lastIndex = ( pModuleContext->signalHistoryNext + CELLULAR_BG770_SIGNAL_HISTORY_SIZE - 1U ) %
+                    CELLULAR_BG770_SIGNAL_HISTORY_SIZE;
+
+        if( pModuleContext->signalHistoryEnabled == false )
+        {
+            /* The URC is on for a signal strength callback only. */
+        }
+        else if( ( pModuleContext->signalHistoryCount > 0U ) &&
+                 ( ( nowTicks - pModuleContext->signalHistory[ lastIndex ].timestampTicks ) < minIntervalTicks ) )
+        {
+            pSummary->rateLimitedCount++;
+        }
+        else
+        {
+            pSample = &pModuleContext->signalHistory[ pModuleContext->signalHistoryNext ];
+            pSample->timestampTicks = nowTicks;
+            pSample->rssi = pSignalInfo->rssi;
+            pSample->ber = pSignalInfo->ber;
+            pModuleContext->signalHistoryNext = ( pModuleContext->signalHistoryNext + 1U ) % CELLULAR_BG770_SIGNAL_HISTORY_SIZE;
+
+            if( pModuleContext->signalHistoryCount < CELLULAR_BG770_SIGNAL_HISTORY_SIZE )
+            {
+                pModuleContext->signalHistoryCount++;
+            }
+
+            pSummary->storedCount++;
+
+            if( pSignalInfo->rssi == CELLULAR_INVALID_SIGNAL_VALUE )
+            {
+                /* Kept in the history, left out of the summary. */
+            }
+            else if( pSummary->rssiEwma == CELLULAR_INVALID_SIGNAL_VALUE )
+            {
+                pSummary->rssiMin = pSignalInfo->rssi;
+                pSummary->rssiMax = pSignalInfo->rssi;
+                pModuleContext->signalRssiEwmaScaled = ( int32_t ) pSignalInfo->rssi * CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT;
+                pSummary->rssiEwma = pSignalInfo->rssi;
+            }
+            else
+            {
+                pSummary->rssiMin = ( pSignalInfo->rssi < pSummary->rssiMin ) ? pSignalInfo->rssi : pSummary->rssiMin;
+                pSummary->rssiMax = ( pSignalInfo->rssi > pSummary->rssiMax ) ? pSignalInfo->rssi : pSummary->rssiMax;
+                pModuleContext->signalRssiEwmaScaled += ( int32_t ) pSignalInfo->rssi -
+                                                        ( pModuleContext->signalRssiEwmaScaled / CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT );
+                pSummary->rssiEwma = ( int16_t ) ( pModuleContext->signalRssiEwmaScaled / CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT );
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->signalHistoryMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetSignalHistory( CellularSignalSample_t * pSamples,
+                                                 uint8_t maxCount,
+                                                 uint8_t * pCount,
+                                                 CellularSignalHistorySummary_t * pSummary )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint8_t count = 0;
+    uint8_t first = 0;
+    uint8_t i = 0;
+
+    if( ( pSamples != NULL ) && ( pCount == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.signalHistoryMutex );
+
+        if( pSamples != NULL )
+        {
+            count = ( maxCount < cellularBg770Context.signalHistoryCount ) ? maxCount : cellularBg770Context.signalHistoryCount;
+
+            /* The newest count samples, oldest first. */
+            first = ( cellularBg770Context.signalHistoryNext + CELLULAR_BG770_SIGNAL_HISTORY_SIZE - count ) %
+                    CELLULAR_BG770_SIGNAL_HISTORY_SIZE;
+
+            for( i = 0; i < count; i++ )
+            {
+                pSamples[ i ] = cellularBg770Context.signalHistory[ ( first + i ) % CELLULAR_BG770_SIGNAL_HISTORY_SIZE ];
+            }
+
+            *pCount = count;
+        }
+
+        if( pSummary != NULL )
+        {
+            *pSummary = cellularBg770Context.signalHistorySummary;
+        }
+
+        PlatformMutex_Unlock( &cellularBg770Context.signalHistoryMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_ResetSignalHistory( void )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.signalHistoryMutex );
+        _resetSignalHistory( &cellularBg770Context );
+        PlatformMutex_Unlock( &cellularBg770Context.signalHistoryMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetPsmTimeline( CellularPsmTimeline_t * pPsmTimeline )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pPsmTimeline == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.psmMutex );
+        *pPsmTimeline = cellularBg770Context.psmTimeline;
+        PlatformMutex_Unlock( &cellularBg770Context.psmMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetAutoPsmEntry( CellularHandle_t cellularHandle,
+                                          uint32_t idleTimeoutMs )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->autoPsmMutex );
+
+        if( ( idleTimeoutMs != 0U ) && ( pModuleContext->pAutoPsmEvent == NULL ) )
+        {
+            pModuleContext->pAutoPsmContext = pContext;
+            pModuleContext->pAutoPsmEvent = ( PlatformEventGroupHandle_t ) PlatformEventGroup_Create();
+
+            if( pModuleContext->pAutoPsmEvent == NULL )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+            else
+            {
+                ( void ) PlatformEventGroup_ClearBits( ( PlatformEventGroupHandle_t ) pModuleContext->pAutoPsmEvent,
+                                                       ( PlatformEventGroup_EventBits ) ( AUTO_PSM_EVT_MASK_STOP | AUTO_PSM_EVT_MASK_STOPPED ) );
+
+                if( Platform_CreateDetachedThread( _autoPsmThread, ( void * ) pModuleContext,
+                                                   CELLULAR_BG770_AUTO_PSM_PRIORITY,
+                                                   CELLULAR_BG770_AUTO_PSM_STACK_SIZE ) != true )
+                {
+                    LogError( ( "Cellular_SetAutoPsmEntry: failed to create idle monitor thread" ) );
+                    ( void ) PlatformEventGroup_Delete( pModuleContext->pAutoPsmEvent );
+                    pModuleContext->pAutoPsmEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+                    cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+                }
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* The quiet period starts now. */
+            pModuleContext->autoPsmIdleTimeoutMs = idleTimeoutMs;
+            pModuleContext->lastActivityTicks = _Cellular_GetTicks();
+            pModuleContext->autoPsmRequested = false;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->autoPsmMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetAutoPsmStats( CellularAutoPsmStats_t * pStats )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.autoPsmMutex );
+        *pStats = cellularBg770Context.autoPsmStats;
+        pStats->idleTimeoutMs = cellularBg770Context.autoPsmIdleTimeoutMs;
+        pStats->idleMs = ( uint32_t ) ( ( ( uint64_t ) ( _Cellular_GetTicks() - cellularBg770Context.lastActivityTicks ) * 1000U ) /
+                                        ( uint64_t ) configTICK_RATE_HZ );
+        pStats->pendingRecvSocketMask = cellularBg770Context.pendingRecvSocketMask;
+        PlatformMutex_Unlock( &cellularBg770Context.autoPsmMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetHealthMonitorPeriod( CellularHandle_t cellularHandle,
+                                                 uint32_t periodMs )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->healthMonitorMutex );
+
+        if( ( periodMs != 0U ) && ( pModuleContext->pHealthMonitorEvent == NULL ) )
+        {
+            pModuleContext->pHealthMonitorContext = pContext;
+            pModuleContext->pHealthMonitorEvent = ( PlatformEventGroupHandle_t ) PlatformEventGroup_Create();
+
+            if( pModuleContext->pHealthMonitorEvent == NULL )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+            else
+            {
+                ( void ) PlatformEventGroup_ClearBits( ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+                                                       ( PlatformEventGroup_EventBits ) ( HEALTH_MONITOR_EVT_MASK_STOP |
+                                                                                          HEALTH_MONITOR_EVT_MASK_STOPPED |
+                                                                                          HEALTH_MONITOR_EVT_MASK_WAKE ) );
+
+                if( Platform_CreateDetachedThread( _healthMonitorThread, ( void * ) pModuleContext,
+                                                   CELLULAR_BG770_HEALTH_MONITOR_PRIORITY,
+                                                   CELLULAR_BG770_HEALTH_MONITOR_STACK_SIZE ) != true )
+                {
+                    LogError( ( "Cellular_SetHealthMonitorPeriod: failed to create health monitor thread" ) );
+                    ( void ) PlatformEventGroup_Delete( pModuleContext->pHealthMonitorEvent );
+                    pModuleContext->pHealthMonitorEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+                    cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+                }
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            pModuleContext->healthMonitorPeriodMs = periodMs;
+
+            if( pModuleContext->pHealthMonitorEvent != NULL )
+            {
+                ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pHealthMonitorEvent,
+                                                     ( PlatformEventGroup_EventBits ) HEALTH_MONITOR_EVT_MASK_WAKE );
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->healthMonitorMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetHealthSnapshot( CellularHealthSnapshot_t * pSnapshot )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pSnapshot == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.healthMonitorMutex );
+        *pSnapshot = cellularBg770Context.healthSnapshot;
+        PlatformMutex_Unlock( &cellularBg770Context.healthMonitorMutex );
+        pSnapshot->version = CELLULAR_HEALTH_SNAPSHOT_VERSION;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+TickType_t _Cellular_GetTicks( void )
+{
+    TickType_t ticks = 0;
+
+    if( pCellularBg770Clock != NULL )
+    {
+        ticks = pCellularBg770Clock->getTicks();
+    }
+    else
+    {
+        ticks = xTaskGetTickCount();
+    }
+
+    return ticks;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_DelayTicks( TickType_t ticks )
+{
+    if( pCellularBg770Clock != NULL )
+    {
+        pCellularBg770Clock->delayTicks( ticks );
+    }
+    else
+    {
+        vTaskDelay( ticks );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Sleeps one polling step of a wait that started at startTicks, false once waitTicks have passed. */
+static bool _clockPollStep( TickType_t startTicks,
+                            TickType_t waitTicks )
+{
+    TickType_t elapsedTicks = _Cellular_GetTicks() - startTicks;
+    TickType_t stepTicks = CLOCK_POLL_PERIOD_ticks;
+    bool waiting = true;
+
+    if( waitTicks == portMAX_DELAY )
+    {
+        /* No limit, the caller polls until its condition holds. */
+    }
+    else if( elapsedTicks >= waitTicks )
+    {
+        waiting = false;
+    }
+    else if( ( waitTicks - elapsedTicks ) < stepTicks )
+    {
+        stepTicks = waitTicks - elapsedTicks;
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    if( waiting )
+    {
+        _Cellular_DelayTicks( stepTicks );
+    }
+
+    return waiting;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Without a clock, or without a limit, the kernel waits and wakes the task as soon as the bits are set.
+ * Otherwise the kernel cannot time the wait, the bits are polled every CLOCK_POLL_PERIOD_ticks of the clock. */
+PlatformEventGroup_EventBits _Cellular_WaitBits( PlatformEventGroupHandle_t groupEvent,
+                                                 PlatformEventGroup_EventBits uxBitsToWaitFor,
+                                                 BaseType_t xClearOnExit,
+                                                 TickType_t waitTicks )
+{
+    PlatformEventGroup_EventBits uxBits = 0;
+    TickType_t startTicks = 0;
+
+    if( ( pCellularBg770Clock == NULL ) || ( waitTicks == portMAX_DELAY ) )
+    {
+        uxBits = ( PlatformEventGroup_EventBits ) PlatformEventGroup_WaitBits( groupEvent, uxBitsToWaitFor,
+                                                                              xClearOnExit, pdFALSE, waitTicks );
+    }
+    else
+    {
+        startTicks = _Cellular_GetTicks();
+        uxBits = ( PlatformEventGroup_EventBits ) PlatformEventGroup_WaitBits( groupEvent, uxBitsToWaitFor,
+                                                                              xClearOnExit, pdFALSE, ( TickType_t ) 0 );
+
+        while( ( ( uxBits & uxBitsToWaitFor ) == 0U ) && ( _clockPollStep( startTicks, waitTicks ) ) )
+        {
+            uxBits = ( PlatformEventGroup_EventBits ) PlatformEventGroup_WaitBits( groupEvent, uxBitsToWaitFor,
+                                                                                  xClearOnExit, pdFALSE, ( TickType_t ) 0 );
+        }
+    }
+
+    return uxBits;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Same as _Cellular_WaitBits() for an item of a queue. */
+BaseType_t _Cellular_QueueReceive( QueueHandle_t queue,
+                                   void * pItem,
+                                   TickType_t waitTicks )
+{
+    BaseType_t received = pdFALSE;
+    TickType_t startTicks = 0;
+
+    if( ( pCellularBg770Clock == NULL ) || ( waitTicks == portMAX_DELAY ) )
+    {
+        received = xQueueReceive( queue, pItem, waitTicks );
+    }
+    else
+    {
+        startTicks = _Cellular_GetTicks();
+        received = xQueueReceive( queue, pItem, ( TickType_t ) 0 );
+
+        while( ( received != pdTRUE ) && ( _clockPollStep( startTicks, waitTicks ) ) )
+        {
+            received = xQueueReceive( queue, pItem, ( TickType_t ) 0 );
+        }
+    }
+
+    return received;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Same as _Cellular_WaitBits() for room in a queue. */
+BaseType_t _Cellular_QueueSend( QueueHandle_t queue,
+                                const void * pItem,
+                                TickType_t waitTicks )
+{
+    BaseType_t sent = pdFALSE;
+    TickType_t startTicks = 0;
+
+    if( ( pCellularBg770Clock == NULL ) || ( waitTicks == portMAX_DELAY ) )
+    {
+        sent = xQueueSend( queue, pItem, waitTicks );
+    }
+    else
+    {
+        startTicks = _Cellular_GetTicks();
+        sent = xQueueSend( queue, pItem, ( TickType_t ) 0 );
+
+        while( ( sent != pdPASS ) && ( _clockPollStep( startTicks, waitTicks ) ) )
+        {
+            sent = xQueueSend( queue, pItem, ( TickType_t ) 0 );
+        }
+    }
+
+    return sent;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_SetClock( const CellularBg770Clock_t * pClock )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( ( pClock != NULL ) && ( ( pClock->getTicks == NULL ) || ( pClock->delayTicks == NULL ) ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent != NULL )
+    {
+        /* Stored tick counts would mix both clocks. */
+        cellularStatus = CELLULAR_LIBRARY_ALREADY_OPEN;
+    }
+    else
+    {
+        pCellularBg770Clock = pClock;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+TickType_t CellularModule_GetTicks( void )
+{
+    return _Cellular_GetTicks();
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetAdaptiveChunkStats( CellularAdaptiveChunkStats_t * pStats )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.adaptiveChunkMutex );
+        *pStats = cellularBg770Context.adaptiveChunkStats;
+        PlatformMutex_Unlock( &cellularBg770Context.adaptiveChunkMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetThermalGovernorStats( CellularThermalGovernorStats_t * pStats )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.thermalMutex );
+        *pStats = cellularBg770Context.thermalStats;
+        PlatformMutex_Unlock( &cellularBg770Context.thermalMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetDeferredSendStats( CellularDeferredSendStats_t * pStats,
+                                                     uint8_t * pQueuedCount )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( pStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.deferredSendMutex );
+        *pStats = cellularBg770Context.deferredSendStats;
+
+        if( pQueuedCount != NULL )
+        {
+            *pQueuedCount = cellularBg770Context.deferredSendCount;
+        }
+
+        PlatformMutex_Unlock( &cellularBg770Context.deferredSendMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t CellularModule_GetDnsServerScores( CellularDnsServerScore_t * pScores,
+                                                   uint8_t maxCount,
+                                                   uint8_t * pCount )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint8_t i = 0;
+
+    if( ( pScores == NULL ) || ( pCount == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( cellularBg770Context.pInitEvent == NULL )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        PlatformMutex_Lock( &cellularBg770Context.dnsCacheMutex );
+
+        for( i = 0; ( i < maxCount ) && ( i < cellularBg770Context.dnsServerCount ); i++ )
+        {
+            pScores[ i ] = cellularBg770Context.dnsServerScores[ i ];
+            pScores[ i ].primary = ( i == cellularBg770Context.dnsPrimaryServerIndex );
+            pScores[ i ].secondary = ( i == cellularBg770Context.dnsSecondaryServerIndex );
+        }
+
+        *pCount = i;
+        PlatformMutex_Unlock( &cellularBg770Context.dnsCacheMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
 /**< NOTE: pFlowControlTypeString is expected to contain no whitespace. */
 static BG770FlowControlType_t _getFlowControlType( const char * pFlowControlTypeString )
 {
@@ -1700,7 +3836,7 @@ static CellularError_t _GetFlowControlStateWithRetryTimeout( CellularHandle_t ce
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             cellularStatus = _GetFlowControlState( cellularHandle, pFlowControlState, commandTimeoutMS );
@@ -1950,7 +4086,7 @@ static CellularError_t _GetUEFunctionalityLevelWithRetryTimeout( CellularHandle_
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             cellularStatus = _GetUEFunctionalityLevel( cellularHandle, pUEFunctionalityLevel, commandTimeoutMS );
@@ -2221,7 +4357,7 @@ static CellularError_t _GetNetworkCategorySearchModeWithRetryTimeout( CellularHa
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             cellularStatus = _GetNetworkCategorySearchMode( cellularHandle, pNetworkCategorySearchMode, commandTimeoutMS );
@@ -2739,7 +4875,7 @@ static CellularError_t _GetRATScanSequenceWithRetryTimeout( CellularHandle_t cel
         {
             if (tryCount > 0) {
                 // increasing backoff
-                vTaskDelay( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
+                _Cellular_DelayTicks( pdMS_TO_TICKS( exponentialBackoffInterCommandBaseMS * (uint32_t)tryCount * tryCount ) );
             }
 
             cellularStatus = _GetRATScanSequence( cellularHandle, pRATScanSequence, commandTimeoutMS );
@@ -67,6 +67,148 @@
 #include "cellular_platform.h"
 #include "cellular_common.h"
 
+/* Define CELLULAR_BG770_URC_DEFERRED_DISPATCH in cellular_config.h to run the application URC callbacks
+ * on a dedicated worker thread instead of the pktio reader thread. */
+#ifndef CELLULAR_BG770_URC_EVENT_QUEUE_LENGTH
+    #define CELLULAR_BG770_URC_EVENT_QUEUE_LENGTH    ( 16U )
+#endif
+
+#ifndef CELLULAR_BG770_URC_WORKER_STACK_SIZE
+    #define CELLULAR_BG770_URC_WORKER_STACK_SIZE     ( PLATFORM_THREAD_DEFAULT_STACK_SIZE )
+#endif
+
+#ifndef CELLULAR_BG770_URC_WORKER_PRIORITY
+    #define CELLULAR_BG770_URC_WORKER_PRIORITY       ( PLATFORM_THREAD_DEFAULT_PRIORITY )
+#endif
+
+/* Define CELLULAR_BG770_PSM_TIMER_URC in cellular_config.h to have the modem report the network assigned
+ * PSM timers with the QPSMTIMER URC, which keeps the PSM timeline of CellularModule_GetPsmTimeline(). */
+
+/* Number of AT+QIDNSGIP queries that may wait for their result at the same time. */
+#ifndef CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES
+    #define CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES    ( 4U )
+#endif
+
+/* Number of host names kept in the DNS result cache, at least 1. */
+#ifndef CELLULAR_BG770_DNS_CACHE_SIZE
+    #define CELLULAR_BG770_DNS_CACHE_SIZE            ( 4U )
+#endif
+
+/* Longer host names are resolved but not cached. */
+#ifndef CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE
+    #define CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE    ( 64U )
+#endif
+
+/* Cellular_RefreshDnsCache() re-resolves entries whose TTL ends within this many seconds. */
+#ifndef CELLULAR_BG770_DNS_REFRESH_AHEAD_SECONDS
+    #define CELLULAR_BG770_DNS_REFRESH_AHEAD_SECONDS       ( 30U )
+#endif
+
+/* Cache hits an entry needs before Cellular_RefreshDnsCache() considers it hot. */
+#ifndef CELLULAR_BG770_DNS_REFRESH_AHEAD_MIN_HITS
+    #define CELLULAR_BG770_DNS_REFRESH_AHEAD_MIN_HITS      ( 2U )
+#endif
+
+/* Upper bound applied to the TTL reported by the modem. Set to 0 to disable the DNS cache. */
+#ifndef CELLULAR_BG770_DNS_CACHE_MAX_TTL_SECONDS
+    #define CELLULAR_BG770_DNS_CACHE_MAX_TTL_SECONDS       ( 3600U )
+#endif
+
+/* Number of DNS servers Cellular_ProbeDnsServers() chooses from. */
+#ifndef CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES
+    #define CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES       ( 4U )
+#endif
+
+/* A faster server replaces the primary only when its score is lower by at least this percentage. */
+#ifndef CELLULAR_BG770_DNS_RESELECT_MARGIN_PERCENT
+    #define CELLULAR_BG770_DNS_RESELECT_MARGIN_PERCENT     ( 20U )
+#endif
+
+/* Number of QIND csq samples kept by the signal history, at least 1. */
+#ifndef CELLULAR_BG770_SIGNAL_HISTORY_SIZE
+    #define CELLULAR_BG770_SIGNAL_HISTORY_SIZE             ( 16U )
+#endif
+
+/* Samples arriving sooner than this after the last stored one are counted but not stored. */
+#ifndef CELLULAR_BG770_SIGNAL_HISTORY_MIN_INTERVAL_MS
+    #define CELLULAR_BG770_SIGNAL_HISTORY_MIN_INTERVAL_MS  ( 5000U )
+#endif
+
+/* Each stored sample moves the RSSI moving average by 1 / CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT. */
+#ifndef CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT
+    #define CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT      ( 8 )
+#endif
+
+/* Payloads Cellular_SocketSendDeferred() holds until the next PSM active window, at least 1. */
+#ifndef CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH
+    #define CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH      ( 4U )
+#endif
+
+/* Largest payload Cellular_SocketSendDeferred() accepts, each queue slot holds a copy. */
+#ifndef CELLULAR_BG770_DEFERRED_SEND_MAX_DATA_SIZE
+    #define CELLULAR_BG770_DEFERRED_SEND_MAX_DATA_SIZE     ( 256U )
+#endif
+
+/* Radio time of one wake from PSM on top of the active time T3324, for the airtime saved estimate. */
+#ifndef CELLULAR_BG770_DEFERRED_SEND_WAKE_OVERHEAD_MS
+    #define CELLULAR_BG770_DEFERRED_SEND_WAKE_OVERHEAD_MS  ( 3000U )
+#endif
+
+/* Period at which the automatic PSM entry checks whether the modem has gone idle. */
+#ifndef CELLULAR_BG770_AUTO_PSM_CHECK_INTERVAL_MS
+    #define CELLULAR_BG770_AUTO_PSM_CHECK_INTERVAL_MS      ( 1000U )
+#endif
+
+#ifndef CELLULAR_BG770_AUTO_PSM_STACK_SIZE
+    #define CELLULAR_BG770_AUTO_PSM_STACK_SIZE             ( PLATFORM_THREAD_DEFAULT_STACK_SIZE )
+#endif
+
+#ifndef CELLULAR_BG770_AUTO_PSM_PRIORITY
+    #define CELLULAR_BG770_AUTO_PSM_PRIORITY               ( PLATFORM_THREAD_DEFAULT_PRIORITY )
+#endif
+
+/* A data transfer counts as active until this long after its last socket or DNS AT request. */
+#ifndef CELLULAR_BG770_DATA_TRANSFER_QUIET_MS
+    #define CELLULAR_BG770_DATA_TRANSFER_QUIET_MS          ( 2000U )
+#endif
+
+#ifndef CELLULAR_BG770_HEALTH_MONITOR_STACK_SIZE
+    #define CELLULAR_BG770_HEALTH_MONITOR_STACK_SIZE       ( PLATFORM_THREAD_DEFAULT_STACK_SIZE )
+#endif
+
+#ifndef CELLULAR_BG770_HEALTH_MONITOR_PRIORITY
+    #define CELLULAR_BG770_HEALTH_MONITOR_PRIORITY         ( PLATFORM_THREAD_DEFAULT_PRIORITY )
+#endif
+
+/* Adaptive send chunking. The chunk never drops below MIN_SIZE and grows by INCREASE after a prompt full
+ * chunk. A send slower than SLOW_SEND_MS, or failed, halves it. Older signal readings are not used. */
+#ifndef CELLULAR_BG770_ADAPTIVE_CHUNK_MIN_SIZE
+    #define CELLULAR_BG770_ADAPTIVE_CHUNK_MIN_SIZE         ( 128U )
+#endif
+
+#ifndef CELLULAR_BG770_ADAPTIVE_CHUNK_INCREASE
+    #define CELLULAR_BG770_ADAPTIVE_CHUNK_INCREASE         ( 128U )
+#endif
+
+#ifndef CELLULAR_BG770_ADAPTIVE_CHUNK_SLOW_SEND_MS
+    #define CELLULAR_BG770_ADAPTIVE_CHUNK_SLOW_SEND_MS     ( 5000U )
+#endif
+
+#ifndef CELLULAR_BG770_ADAPTIVE_CHUNK_SIGNAL_MAX_AGE_MS
+    #define CELLULAR_BG770_ADAPTIVE_CHUNK_SIGNAL_MAX_AGE_MS    ( 60000U )
+#endif
+
+/* Number of throttle steps of the thermal governor. */
+#ifndef CELLULAR_BG770_THERMAL_STEP_COUNT
+    #define CELLULAR_BG770_THERMAL_STEP_COUNT              ( 3U )
+#endif
+
+/* Hold-down after a DNS server failure during which the same host name fails without a query.
+ * Set to 0 to disable negative caching. */
+#ifndef CELLULAR_BG770_DNS_NEGATIVE_CACHE_SECONDS
+    #define CELLULAR_BG770_DNS_NEGATIVE_CACHE_SECONDS      ( 10U )
+#endif
+
 /**
  * @brief DNS query result.
  */
@@ -78,6 +220,42 @@ typedef enum cellularDnsQueryResult
     CELLULAR_DNS_QUERY_UNKNOWN
 } cellularDnsQueryResult_t;
 
+/**
+ * @brief Completion of one DNS query, passed from the URC handler to the requester.
+ */
+typedef struct cellularDnsQueryCompletion
+{
+    cellularDnsQueryResult_t result;
+    uint32_t timeToLiveSeconds;     /* TTL reported by the modem, 0 if not reported. */
+    uint8_t addressCount;           /* Addresses stored for a multiple result query. */
+    int32_t resultCode;             /* Result code of the URC header, -1 if none was parsed. */
+} cellularDnsQueryCompletion_t;
+
+/**
+ * @brief One AT+QIDNSGIP query slot.
+ *
+ * A slot is owned by its requester until the requester returns and is pending from the time the command is
+ * sent until the last line of its URC has been consumed. It is free when neither is set.
+ */
+typedef struct cellularDnsQuery
+{
+    bool owned;
+    bool pending;
+    bool completed;                 /* The requester has been sent its completion. */
+    uint32_t sequence;              /* Send order, URC results belong to the pending query with the lowest value. */
+    TickType_t sentTicks;
+    uint8_t contextId;
+    QueueHandle_t resultQueue;      /* Receives the cellularDnsQueryCompletion_t of this query. */
+    uint8_t resultNumber;           /* IP count of the URC header, 0 until the header is received. */
+    uint8_t resultIndex;            /* Address lines consumed so far. */
+    uint32_t timeToLiveSeconds;
+    int32_t resultCode;
+    char * pResolvedAddress;                    /* Single result query destination. */
+    CellularIPAddress_t * pResolvedAddresses;   /* Multiple result query destination. */
+    uint8_t resolvedAddressesMax;
+    uint8_t resolvedAddressCount;
+} cellularDnsQuery_t;
+
 typedef enum CellularModuleFullInitSkippedResult
 {
     CELLULAR_FULL_INIT_SKIPPED_RESULT_YES,
@@ -85,8 +263,317 @@ typedef enum CellularModuleFullInitSkippedResult
     CELLULAR_FULL_INIT_SKIPPED_RESULT_ERROR     /* Error caused yes/no result to be irrelevant */
 } CellularModuleFullInitSkippedResult_t;
 
+/**
+ * @brief Priority class of an AT request issued by this port.
+ *        When several requests are queued, the lowest class value is sent first.
+ *
+ * Only the port requests listed with each class go through the lanes. Other requests bypass them and take
+ * the AT interface whenever the common library lets them: configuration queries of the port, the calls the
+ * common library implements such as Cellular_GetRegisteredNetwork() and Cellular_GetServiceStatus(), and
+ * Cellular_ATCommandRaw().
+ */
+typedef enum CellularAtPriorityClass
+{
+    CELLULAR_AT_PRIORITY_CONTROL,       /* Power down, PSM entry, socket close and PDN deactivation. */
+    CELLULAR_AT_PRIORITY_DATA,          /* Socket connect/send/receive, PDN activation and DNS. */
+    CELLULAR_AT_PRIORITY_BACKGROUND,    /* Telemetry polls such as signal quality and temperatures. */
+    CELLULAR_AT_PRIORITY_MAX
+} CellularAtPriorityClass_t;
+
+/**
+ * @brief Queueing statistics of one AT request priority class.
+ */
+typedef struct CellularAtPriorityStats
+{
+    uint32_t requestCount;          /* Requests admitted in this class. */
+    uint32_t preemptedCount;        /* Times a request had to let a higher class go first. */
+    uint32_t lastQueueDelayMs;      /* Queueing delay of the most recent request. */
+    uint32_t maxQueueDelayMs;       /* Largest queueing delay observed. */
+    uint64_t totalQueueDelayMs;     /* Sum of all queueing delays, divide by requestCount for the mean. */
+    uint32_t timedOutCount;         /* Requests that gave up because their deadline expired while queued. */
+} CellularAtPriorityStats_t;
+
+/**
+ * @brief Statistics of the deferred URC callback dispatch.
+ */
+typedef struct CellularUrcDispatchStats
+{
+    uint32_t postedCount;           /* Events queued by the pktio reader thread. */
+    uint32_t dispatchedCount;       /* Events delivered by the URC worker thread. */
+    uint32_t overflowCount;         /* Events dropped because the queue was full. */
+    uint32_t highWaterMark;         /* Largest number of events queued at once. */
+    uint32_t staleDroppedCount;     /* Socket events dropped because their socket was closed while queued. */
+} CellularUrcDispatchStats_t;
+
+/**
+ * @brief Statistics of the DNS result cache.
+ */
+typedef struct CellularDnsCacheStats
+{
+    uint32_t hitCount;              /* Lookups answered from the cache. */
+    uint32_t missCount;             /* Lookups that needed an AT+QIDNSGIP query. */
+    uint32_t expiredCount;          /* Misses caused by an entry whose TTL had run out. */
+    uint32_t evictionCount;         /* Live entries replaced to make room for a new host name. */
+    uint32_t invalidationCount;     /* Entries dropped on PDN deactivation or flush. */
+    uint32_t refreshCount;          /* Entries re-resolved ahead of their expiry. */
+    uint32_t refreshFailureCount;   /* Refresh-ahead queries that failed, the entry is left to expire. */
+    uint32_t refreshedHitCount;     /* Hits on refreshed entries, lookups that would otherwise have gone cold. */
+    uint32_t negativeInsertCount;   /* Failures held down. */
+    uint32_t negativeHitCount;      /* Lookups failed immediately during a hold-down. */
+    int32_t lastFailureResultCode;  /* Modem result code of the last held down failure, 0 if the IP count was zero. */
+} CellularDnsCacheStats_t;
+
+/**
+ * @brief One stored QIND csq sample.
+ */
+typedef struct CellularSignalSample
+{
+    TickType_t timestampTicks;
+    int16_t rssi;                   /* dBm, CELLULAR_INVALID_SIGNAL_VALUE if unknown. */
+    int16_t ber;                    /* CELLULAR_INVALID_SIGNAL_VALUE if unknown. */
+} CellularSignalSample_t;
+
+/**
+ * @brief Summary of the samples stored in the signal history since the last reset.
+ */
+typedef struct CellularSignalHistorySummary
+{
+    uint32_t storedCount;           /* Samples stored, older ones may since have been overwritten. */
+    uint32_t rateLimitedCount;      /* Samples dropped by CELLULAR_BG770_SIGNAL_HISTORY_MIN_INTERVAL_MS. */
+    int16_t rssiMin;                /* CELLULAR_INVALID_SIGNAL_VALUE until a valid RSSI was stored. */
+    int16_t rssiMax;
+    int16_t rssiEwma;
+} CellularSignalHistorySummary_t;
+
+/**
+ * @brief PSM timers reported by the QPSMTIMER URC and the modem's predicted PSM timeline.
+ *        Tick values are only meaningful while the matching flag is set.
+ */
+typedef struct CellularPsmTimeline
+{
+    bool timersKnown;
+    uint32_t periodicTauSeconds;    /* T3412 (extended), 0 if deactivated by the network. */
+    uint32_t activeTimeSeconds;     /* T3324, 0 if deactivated by the network. */
+    TickType_t timersReceivedTicks;
+    bool inPsm;                     /* Between PSM POWER DOWN and the next RDY. */
+    TickType_t psmEnteredTicks;
+    TickType_t lastWakeTicks;       /* RDY after PSM, or the last QPSMTIMER if the modem was not seen in PSM. */
+    TickType_t nextPsmEntryTicks;   /* Predicted, lastWakeTicks + T3324. */
+    TickType_t nextTauWakeTicks;    /* Predicted, the modem wakes for its periodic TAU. At most half the tick range ahead. */
+    uint32_t psmEntryCount;
+} CellularPsmTimeline_t;
+
+/**
+ * @brief Counters of the PSM aligned deferred send scheduler.
+ */
+typedef struct CellularDeferredSendStats
+{
+    uint32_t queuedCount;
+    uint32_t sentCount;
+    uint32_t failedCount;           /* Sends that failed, or payloads dropped when their socket was closed. */
+    uint32_t flushCount;
+    uint32_t forcedFlushCount;      /* Flushes outside an active window, each waking the modem. */
+    uint32_t wakeupsAvoided;        /* Payloads queued outside an active window that shared another wake. */
+    uint64_t airtimeSavedMs;        /* Estimated, each avoided wake costs T3324 and the wake overhead. A long
+                                     * T3324 costs hours per wake, 64 bits keep the sum from wrapping. */
+} CellularDeferredSendStats_t;
+
+/**
+ * @brief State and counters of the automatic PSM entry.
+ */
+typedef struct CellularAutoPsmStats
+{
+    uint32_t idleTimeoutMs;         /* 0 while disabled. */
+    uint32_t idleMs;                /* Since the last prioritized AT request or receive URC. */
+    uint32_t pendingRecvSocketMask; /* Bit per socket id with a receive URC not yet read out. */
+    uint32_t entryRequestCount;
+    uint32_t entryFailureCount;
+    uint32_t pendingRecvBlockCount; /* Idle checks held back by unread data. */
+} CellularAutoPsmStats_t;
+
+/**
+ * @brief eDRX parameters negotiated with the network and the estimated paging windows.
+ *        The modem was paged when a receive URC arrived, the last one is taken as the start of a window.
+ */
+typedef struct CellularEdrxTimeline
+{
+    bool edrxActive;                /* The network granted eDRX. */
+    uint8_t actType;                /* <AcT-type> of AT+CEDRXRDP, 4 for LTE-M and 5 for NB-IoT. */
+    uint8_t requestedEdrxValue;
+    uint8_t nwProvidedEdrxValue;
+    uint8_t pagingTimeWindowValue;
+    uint32_t edrxCycleMs;
+    uint32_t pagingTimeWindowMs;
+    bool anchorKnown;
+    TickType_t anchorTicks;
+    bool inPagingWindow;            /* At the time of the read, only meaningful with anchorKnown. */
+    uint32_t nextPagingWindowMs;    /* From the time of the read, 0 inside a window. */
+    uint32_t heldCount;             /* Cellular_WaitForPagingWindow() calls that had to wait. */
+    uint32_t heldTotalMs;
+} CellularEdrxTimeline_t;
+
+/* Version of CellularHealthSnapshot_t, incremented when its layout changes. */
+#define CELLULAR_HEALTH_SNAPSHOT_VERSION          ( 1U )
+
+/* CellularHealthSnapshot_t validMask bits, set for each part read successfully. */
+#define CELLULAR_HEALTH_VALID_SIGNAL_INFO         ( 0x01U )
+#define CELLULAR_HEALTH_VALID_TEMPERATURES        ( 0x02U )
+#define CELLULAR_HEALTH_VALID_LTE_NETWORK_INFO    ( 0x04U )
+#define CELLULAR_HEALTH_VALID_SERVICE_STATUS      ( 0x08U )
+
+/**
+ * @brief Modem health sampled by the health monitor in one pass.
+ */
+typedef struct CellularHealthSnapshot
+{
+    uint32_t version;               /* CELLULAR_HEALTH_SNAPSHOT_VERSION. */
+    uint32_t sequence;              /* Incremented for every snapshot published, 0 before the first. */
+    TickType_t sampledTicks;
+    uint32_t validMask;
+    CellularSignalInfo_t signalInfo;
+    CellularTemperatures_t temperatures;
+    CellularLTENetworkInfo_t lteNetworkInfo;
+    CellularServiceStatus_t serviceStatus;
+    uint32_t skippedInPsmCount;     /* Passes skipped because the modem was in PSM. */
+    uint32_t skippedForDataCount;   /* Passes skipped because a data transfer was active. */
+} CellularHealthSnapshot_t;
+
+/**
+ * @brief Time source of the port, in place of xTaskGetTickCount() and vTaskDelay().
+ */
+typedef struct CellularBg770Clock
+{
+    TickType_t ( * getTicks )( void );
+    void ( * delayTicks )( TickType_t ticks );
+} CellularBg770Clock_t;
+
+/**
+ * @brief Adaptive send chunking state and counters.
+ */
+typedef struct CellularAdaptiveChunkStats
+{
+    bool enabled;
+    uint32_t chunkSize;              /* Current AIMD chunk size in bytes. */
+    uint32_t signalCapSize;          /* Limit from the last signal reading, CELLULAR_MAX_SEND_DATA_LEN if none. */
+    int16_t rsrp;                    /* dBm, CELLULAR_INVALID_SIGNAL_VALUE if unknown. */
+    int16_t sinr;                    /* dB, CELLULAR_INVALID_SIGNAL_VALUE if unknown. */
+    uint32_t sendCount;
+    uint32_t failedSendCount;
+    uint32_t increaseCount;
+    uint32_t decreaseCount;
+    uint32_t bytesSent;
+    uint32_t sendTimeTotalMs;        /* Time spent in AT+QISEND, failed sends included. */
+    uint32_t goodputBytesPerSecond;  /* bytesSent over sendTimeTotalMs. */
+} CellularAdaptiveChunkStats_t;
+
+/**
+ * @brief Thermal governor settings. Step n, counted from 1, applies from thresholdCelsius[ n - 1 ].
+ */
+typedef struct CellularThermalGovernorConfig
+{
+    int16_t thresholdCelsius[ CELLULAR_BG770_THERMAL_STEP_COUNT ];  /* Ascending. */
+    uint32_t maxChunkSize[ CELLULAR_BG770_THERMAL_STEP_COUNT ];     /* Bytes per send at each step. */
+    uint32_t interSendDelayMs[ CELLULAR_BG770_THERMAL_STEP_COUNT ]; /* Wait before each send at each step. */
+    int16_t hysteresisCelsius;      /* A step is left this far below its threshold. */
+    uint32_t sampleIntervalMs;      /* Time between AT+QTEMP reads during a transfer. */
+} CellularThermalGovernorConfig_t;
+
+/**
+ * @brief Thermal governor state and counters.
+ */
+typedef struct CellularThermalGovernorStats
+{
+    uint8_t step;                   /* 0 while not throttling. */
+    int16_t lastTemperatureCelsius; /* Hottest of the AT+QTEMP readings, CELLULAR_INVALID_SIGNAL_VALUE before the first. */
+    uint32_t sampleCount;
+    uint32_t stepChangeCount;
+    uint32_t throttledSendCount;
+    uint32_t delayedTotalMs;
+} CellularThermalGovernorStats_t;
+
+/**
+ * @brief Thermal governor step callback, called in the sending task on every step change.
+ */
+typedef void ( * CellularThermalStepCallback_t )( uint8_t step,
+                                                  int16_t temperatureCelsius,
+                                                  void * pCallbackContext );
+
+/**
+ * @brief PSM timeline callback, called after the timeline changed on a QPSMTIMER, PSM POWER DOWN or RDY URC.
+ */
+typedef void ( * CellularPsmTimelineCallback_t )( const CellularPsmTimeline_t * pPsmTimeline,
+                                                  void * pCallbackContext );
+
+/**
+ * @brief Latency score of one DNS server candidate.
+ */
+typedef struct CellularDnsServerScore
+{
+    char serverAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ];
+    uint32_t latencyScoreMs;        /* Moving average of the probe latency, a failed probe counts as the query timeout. */
+    uint32_t lastLatencyMs;         /* Latency of the most recent probe. */
+    uint32_t probeCount;
+    uint32_t failureCount;
+    bool primary;                   /* Filled by CellularModule_GetDnsServerScores(). */
+    bool secondary;                 /* Filled by CellularModule_GetDnsServerScores(). */
+} CellularDnsServerScore_t;
+
+/**
+ * @brief Outcome of a DNS cache lookup.
+ */
+typedef enum cellularDnsCacheLookupResult
+{
+    CELLULAR_DNS_CACHE_MISS,
+    CELLULAR_DNS_CACHE_HIT,
+    CELLULAR_DNS_CACHE_NEGATIVE_HIT
+} cellularDnsCacheLookupResult_t;
+
+/**
+ * @brief One cached DNS result.
+ */
+typedef struct cellularDnsCacheEntry
+{
+    bool valid;
+    uint8_t contextId;
+    TickType_t expiryTicks;
+    uint32_t lastUsed;      /* Value of dnsCacheUseCounter at the last hit, the smallest is evicted first. */
+    uint32_t hitCount;      /* Hits since the host name was added, kept across refreshes. */
+    bool refreshAttempted;  /* Refresh-ahead tried since the last insertion. */
+    bool refreshed;         /* The current result came from a refresh-ahead. */
+    bool negative;          /* Held down failure, address is empty and failureResultCode is the reason. */
+    int32_t failureResultCode;
+    char hostName[ CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE + 1U ];
+    char address[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ];
+} cellularDnsCacheEntry_t;
+
+/**
+ * @brief One payload held by the deferred send scheduler.
+ */
+typedef struct cellularDeferredSend
+{
+    CellularSocketHandle_t socketHandle;
+    bool outsideActiveWindow;       /* Sending it right away would have woken the modem. */
+    uint32_t dataLength;
+    uint8_t data[ CELLULAR_BG770_DEFERRED_SEND_MAX_DATA_SIZE ];
+} cellularDeferredSend_t;
+
+/**
+ * @brief Socket activity reported to the idle tracker of the automatic PSM entry.
+ */
+typedef enum cellularIdleActivity
+{
+    CELLULAR_IDLE_ACTIVITY_RECV_PENDING,    /* Receive URC, the data waits in the modem. */
+    CELLULAR_IDLE_ACTIVITY_RECV_DRAINED     /* A read returned less than asked, or the socket was closed. */
+} cellularIdleActivity_t;
+
 typedef struct cellularModuleContext cellularModuleContext_t;
 
+/**
+ * @brief SIM insertion state changed callback, called with the new state from the QSIMSTAT URC or a poll.
+ */
+typedef void ( * CellularUrcSimStateChangedCallback_t )( CellularSimCardState_t simCardState,
+                                                         void * pCallbackContext );
+
 /**
  * @brief DNS query URC callback fucntion.
  */
@@ -97,26 +584,230 @@ typedef void ( * CellularDnsResultEventCallback_t )( cellularModuleContext_t * p
 typedef struct cellularModuleContext
 {
     /* DNS related variables. */
-    PlatformMutex_t dnsQueryMutex; /* DNS query mutex to protect the following data. */
-    QueueHandle_t pktDnsQueue;     /* DNS queue to receive the DNS query result. */
-    uint8_t dnsResultNumber;       /* DNS query result number. */
-    uint8_t dnsIndex;              /* DNS query current index. */
+    PlatformMutex_t dnsQueryMutex;   /* Held while a query slot is claimed and its AT+QIDNSGIP sent. */
+    PlatformMutex_t dnsPendingMutex; /* Protects dnsQueries and dnsQuerySequence, never held across an AT command. */
+    cellularDnsQuery_t dnsQueries[ CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES ];
+    uint32_t dnsQuerySequence;
     char * pDnsUsrData;            /* DNS user data to store the result. */
     CellularDnsResultEventCallback_t dnsEventCallback;
 
+    /* DNS result cache. */
+    PlatformMutex_t dnsCacheMutex; /* Protects the following data, never held across an AT command. */
+    cellularDnsCacheEntry_t dnsCache[ CELLULAR_BG770_DNS_CACHE_SIZE ];
+    uint32_t dnsCacheUseCounter;
+    CellularDnsCacheStats_t dnsCacheStats;
+
+    /* DNS server selection, also protected by dnsCacheMutex. */
+    CellularDnsServerScore_t dnsServerScores[ CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES ];
+    uint8_t dnsServerCount;
+    uint8_t dnsServerContextId;
+    uint8_t dnsPrimaryServerIndex;
+    uint8_t dnsSecondaryServerIndex;   /* CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES if there is none. */
+    uint32_t dnsServerSwitchCount;
+    bool dnsProbeInProgress;
+
+    /* SIM and modem identity cache. */
+    PlatformMutex_t identityCacheMutex; /* Protects the following data, never held across an AT command. */
+    uint32_t identityGeneration;        /* Incremented on every invalidation, reads started before are not stored. */
+    bool simCardInfoValid;
+    CellularSimCardInfo_t simCardInfo;
+    bool modemInfoValid;
+    CellularModemInfo_t modemInfo;
+
+    /* SIM insertion state, also protected by identityCacheMutex. */
+    bool simStateKnown;
+    bool simStateUrcEnabled;           /* Last reported QSIMSTAT <enable>, changes are only seen while it is set. */
+    CellularSimCardState_t simCardState;
+    uint32_t simStateChangeCount;
+    CellularUrcSimStateChangedCallback_t simStateChangedCallback;
+    void * pSimStateChangedCallbackContext;
+
+    /* Serving cell, kept up to date from the CEREG URC. */
+    PlatformMutex_t servingCellMutex;  /* Protects the following data, never held across an AT command. */
+    CellularLTENetworkInfo_t servingCell;
+    bool servingCellKnown;             /* trackingAreaCode and cellId are current. */
+    bool servingCellInfoValid;         /* The AT+QNWINFO fields were read on the current cell. */
+    TickType_t servingCellUpdatedTicks;
+    uint32_t servingCellChangeCount;   /* Also tells a AT+QNWINFO read that the cell changed under it. */
+
+    /* Signal history, fed by the QIND csq URC. */
+    PlatformMutex_t signalHistoryMutex; /* Protects the following data. */
+    bool signalHistoryEnabled;
+    bool signalCallbackRegistered;      /* The QIND csq URC is also needed by the common library callback. */
+    CellularSignalSample_t signalHistory[ CELLULAR_BG770_SIGNAL_HISTORY_SIZE ];
+    uint8_t signalHistoryNext;          /* Slot the next sample is written to. */
+    uint8_t signalHistoryCount;
+    int32_t signalRssiEwmaScaled;       /* RSSI moving average times CELLULAR_BG770_SIGNAL_HISTORY_EWMA_WEIGHT. */
+    CellularSignalHistorySummary_t signalHistorySummary;
+
+    /* PSM timeline, kept from the PSM URCs. */
+    PlatformMutex_t psmMutex;           /* Protects the following data, never held across an AT command. */
+    CellularPsmTimeline_t psmTimeline;
+    CellularPsmTimelineCallback_t psmTimelineCallback;
+    void * pPsmTimelineCallbackContext;
+
+    /* Deferred sends, flushed in the PSM active window. */
+    PlatformMutex_t deferredSendMutex;  /* Protects the following data, never held across an AT command. */
+    cellularDeferredSend_t deferredSends[ CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH ];
+    uint8_t deferredSendHead;           /* Oldest queued payload. */
+    uint8_t deferredSendCount;
+    CellularDeferredSendStats_t deferredSendStats;
+
+    /* Idle tracking for the automatic PSM entry. */
+    PlatformMutex_t autoPsmMutex;       /* Protects the following data, never held across an AT command. */
+    TickType_t lastActivityTicks;
+    uint32_t activeAtRequests;          /* Prioritized AT requests in progress. */
+    uint32_t pendingRecvSocketMask;
+    uint32_t autoPsmIdleTimeoutMs;
+    bool autoPsmRequested;              /* Entry asked for since the last activity or PSM cycle. */
+    CellularAutoPsmStats_t autoPsmStats;
+    PlatformEventGroupHandle_t pAutoPsmEvent;   /* NULL until the idle monitor thread is started. */
+    const CellularContext_t * pAutoPsmContext;
+
+    /* Adaptive send chunking. */
+    PlatformMutex_t adaptiveChunkMutex;  /* Protects the following data, never held across an AT command. */
+    bool linkSignalKnown;
+    TickType_t linkSignalTicks;
+    CellularAdaptiveChunkStats_t adaptiveChunkStats;
+
+    /* Thermal governor. */
+    PlatformMutex_t thermalMutex;        /* Protects the following data, never held across an AT command. */
+    bool thermalGovernorEnabled;
+    CellularThermalGovernorConfig_t thermalConfig;
+    CellularThermalStepCallback_t thermalStepCallback;
+    void * pThermalStepCallbackContext;
+    bool thermalSampled;
+    TickType_t thermalSampleTicks;
+    CellularThermalGovernorStats_t thermalStats;
+
+    /* Health monitor. */
+    PlatformMutex_t healthMonitorMutex;  /* Protects the following data, never held across an AT command. */
+    uint32_t healthMonitorPeriodMs;      /* 0 while paused. */
+    CellularHealthSnapshot_t healthSnapshot;
+    PlatformEventGroupHandle_t pHealthMonitorEvent;   /* NULL until the monitor thread is started. */
+    const CellularContext_t * pHealthMonitorContext;
+
+    /* eDRX parameters and paging window anchor. */
+    PlatformMutex_t edrxMutex;          /* Protects the following data, never held across an AT command. */
+    CellularEdrxTimeline_t edrxTimeline;
+
     /* "APP RDY" URC related variables */
     PlatformEventGroupHandle_t pInitEvent;
 
+    /* AT request priority lanes. */
+    PlatformMutex_t atPriorityMutex;             /* Protects the following data. */
+    PlatformEventGroupHandle_t pAtPriorityEvent; /* One bit per priority class, set when that class may proceed. */
+    bool atPriorityBusy;                         /* A prioritized AT request is being sent. */
+    bool atPriorityClosing;                      /* Set by Cellular_ModuleCleanUp(), queued requests stop waiting. */
+    CellularAtPriorityClass_t atPriorityBusyClass;
+    bool dataRequestSeen;
+    TickType_t lastDataRequestTicks;             /* Start or end of the last data class request. */
+    uint8_t atPriorityWaiting[ CELLULAR_AT_PRIORITY_MAX ];
+    CellularAtPriorityStats_t atPriorityStats[ CELLULAR_AT_PRIORITY_MAX ];
+
+    /* Deferred URC callback dispatch. */
+    QueueHandle_t urcEventQueue;                 /* NULL when URC callbacks are run on the pktio reader thread. */
+    PlatformEventGroupHandle_t pUrcWorkerEvent;
+    const CellularContext_t * pUrcEventContext;
+    PlatformMutex_t urcDispatchMutex;            /* Protects the following data. */
+    uint32_t socketGeneration[ CELLULAR_NUM_SOCKET_MAX ]; /* Bumped when a socket is closed, stale queued events are dropped. */
+    CellularUrcDispatchStats_t urcDispatchStats;
+
     /* Forward declaration to declare the callback function prototype. */
     /* coverity[misra_c_2012_rule_1_1_violation]. */
 } cellularModuleContext_t;
 
 CellularPktStatus_t _Cellular_ParseSimstat( char * pInputStr,
-                                            CellularSimCardState_t * pSimState );
+                                            CellularSimCardState_t * pSimState,
+                                            bool * pUrcEnabled );
+
+void _Cellular_SimStateUpdate( const CellularContext_t * pContext,
+                               CellularSimCardState_t simCardState,
+                               bool urcEnabled );
+
+TickType_t _Cellular_GetTicks( void );
+
+void _Cellular_DelayTicks( TickType_t ticks );
+
+PlatformEventGroup_EventBits _Cellular_WaitBits( PlatformEventGroupHandle_t groupEvent,
+                                                 PlatformEventGroup_EventBits uxBitsToWaitFor,
+                                                 BaseType_t xClearOnExit,
+                                                 TickType_t waitTicks );
+
+BaseType_t _Cellular_QueueReceive( QueueHandle_t queue,
+                                   void * pItem,
+                                   TickType_t waitTicks );
+
+BaseType_t _Cellular_QueueSend( QueueHandle_t queue,
+                                const void * pItem,
+                                TickType_t waitTicks );
+
+void _Cellular_IdleTrackerUpdate( const CellularContext_t * pContext,
+                                  cellularIdleActivity_t activity,
+                                  uint32_t socketId );
+
+bool _Cellular_IsDataTransferActive( cellularModuleContext_t * pModuleContext );
+
+CellularError_t _Cellular_AtPriorityAcquire( const CellularContext_t * pContext,
+                                             CellularAtPriorityClass_t priorityClass,
+                                             const TickType_t * pDeadlineTicks,
+                                             bool * pAcquired );
+
+void _Cellular_AtPriorityRelease( const CellularContext_t * pContext );
 
 extern CellularAtParseTokenMap_t CellularUrcHandlerTable[];
 extern uint32_t CellularUrcHandlerTableSize;
 
+CellularError_t _Cellular_UrcDispatchInit( const CellularContext_t * pContext,
+                                           cellularModuleContext_t * pModuleContext );
+
+void _Cellular_UrcDispatchCleanUp( cellularModuleContext_t * pModuleContext );
+
+cellularDnsCacheLookupResult_t _Cellular_DnsCacheLookup( cellularModuleContext_t * pModuleContext,
+                                                         uint8_t contextId,
+                                                         const char * pHostName,
+                                                         char * pResolvedAddress,
+                                                         int32_t * pFailureResultCode );
+
+void _Cellular_DnsCacheInsert( cellularModuleContext_t * pModuleContext,
+                               uint8_t contextId,
+                               const char * pHostName,
+                               const char * pResolvedAddress,
+                               uint32_t timeToLiveSeconds );
+
+void _Cellular_DnsCacheInsertFailure( cellularModuleContext_t * pModuleContext,
+                                      uint8_t contextId,
+                                      const char * pHostName,
+                                      int32_t failureResultCode );
+
+void _Cellular_DnsCacheInvalidate( cellularModuleContext_t * pModuleContext,
+                                   uint8_t contextId );
+
+void _Cellular_DnsQueriesAbort( cellularModuleContext_t * pModuleContext,
+                                uint8_t contextId );
+
+bool _Cellular_DnsCacheGetRefreshCandidate( cellularModuleContext_t * pModuleContext,
+                                            uint8_t * pContextId,
+                                            char * pHostName );
+
+void _Cellular_IdentityCacheInvalidate( cellularModuleContext_t * pModuleContext,
+                                        bool includeModemInfo );
+
+void _Cellular_EdrxNotePaged( const CellularContext_t * pContext );
+
+void _Cellular_ServingCellUpdateFromCereg( const CellularContext_t * pContext,
+                                           char * pCeregPayload );
+
+void _Cellular_ServingCellInvalidate( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SignalHistoryAdd( cellularModuleContext_t * pModuleContext,
+                                 const CellularSignalInfo_t * pSignalInfo );
+
+void _Cellular_DnsCacheRefreshDone( cellularModuleContext_t * pModuleContext,
+                                    uint8_t contextId,
+                                    const char * pHostName,
+                                    bool refreshSucceeded );
+
 extern const char * CellularSrcTokenErrorTable[];
 extern uint32_t CellularSrcTokenErrorTableSize;
 
@@ -152,6 +843,663 @@ CellularError_t CellularModule_SkipInitializationPostHWFlowControlSetupIfChanged
 CellularError_t CellularModule_TryGetDidSkipInitializationPostHWFlowControlSetup(
         CellularModuleFullInitSkippedResult_t * pSkippedResult);
 
+/**
+ * @brief Retrieve the queueing statistics of an AT request priority class.
+ *
+ * @param[in] priorityClass The priority class to report.
+ * @param[out] pStats pointer to memory to place the statistics.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetAtPriorityStats( CellularAtPriorityClass_t priorityClass,
+                                                   CellularAtPriorityStats_t * pStats );
+
+/**
+ * @brief Reset the queueing statistics of all AT request priority classes.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_ResetAtPriorityStats( void );
+
+/**
+ * @brief Retrieve the statistics of the deferred URC callback dispatch.
+ *        All counters stay zero unless CELLULAR_BG770_URC_DEFERRED_DISPATCH is defined.
+ *
+ * @param[out] pStats pointer to memory to place the statistics.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetUrcDispatchStats( CellularUrcDispatchStats_t * pStats );
+
+/**
+ * @brief Retrieve the statistics of the DNS result cache.
+ *
+ * @param[out] pStats pointer to memory to place the statistics.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetDnsCacheStats( CellularDnsCacheStats_t * pStats );
+
+/**
+ * @brief Drop every entry of the DNS result cache, the next Cellular_GetHostByName() of each
+ *        host name queries the network again.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_FlushDnsCache( void );
+
+/**
+ * @brief Retrieve the signal history without any AT traffic.
+ *
+ * @param[out] pSamples Array to place the samples, oldest first. Can be NULL to only get the summary.
+ * @param[in] maxCount Number of entries in pSamples, the newest samples are returned if it is smaller
+ * than the history.
+ * @param[out] pCount Number of samples placed in pSamples.
+ * @param[out] pSummary Min, max and moving average of the RSSI. Can be NULL.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetSignalHistory( CellularSignalSample_t * pSamples,
+                                                 uint8_t maxCount,
+                                                 uint8_t * pCount,
+                                                 CellularSignalHistorySummary_t * pSummary );
+
+/**
+ * @brief Discard the signal history and its summary.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_ResetSignalHistory( void );
+
+/**
+ * @brief Retrieve the PSM timers and the predicted PSM timeline without any AT traffic.
+ *
+ * @param[out] pPsmTimeline Out parameter to provide the timeline.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetPsmTimeline( CellularPsmTimeline_t * pPsmTimeline );
+
+/**
+ * @brief Retrieve the deferred send scheduler counters.
+ *
+ * @param[out] pStats Out parameter to provide the counters.
+ * @param[out] pQueuedCount Number of payloads waiting for an active window. Can be NULL.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetDeferredSendStats( CellularDeferredSendStats_t * pStats,
+                                                     uint8_t * pQueuedCount );
+
+/**
+ * @brief Retrieve the state and counters of the automatic PSM entry.
+ *
+ * @param[out] pStats Out parameter to provide the state and counters.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetAutoPsmStats( CellularAutoPsmStats_t * pStats );
+
+/**
+ * @brief Retrieve the last snapshot published by the health monitor.
+ *
+ * @param[out] pSnapshot Out parameter to provide the snapshot, sequence is 0 before the first one.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetHealthSnapshot( CellularHealthSnapshot_t * pSnapshot );
+
+/**
+ * @brief Replace the time source of the port, for example with a simulated clock on a host.
+ *
+ * The port reads time and sleeps through it, so retry backoffs, deadlines and idle timers follow it. Its own
+ * waits on events, such as APP RDY, the DNS result, the priority lanes and the monitor thread periods, poll
+ * the clock in 10 ms steps. Timeouts inside the common library, the AT response timeouts among them, are out
+ * of scope and keep using the kernel. Call before Cellular_Init().
+ *
+ * @param[in] pClock The time source, NULL for the FreeRTOS kernel. It is referenced, not copied.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_SetClock( const CellularBg770Clock_t * pClock );
+
+/**
+ * @brief Read the time source of the port, the one set with CellularModule_SetClock().
+ *
+ * Deadlines passed to the *WithDeadline functions are compared against this tick count, so compute them from
+ * it rather than from xTaskGetTickCount() when a clock is set.
+ *
+ * @return The current tick count of the port.
+ */
+TickType_t CellularModule_GetTicks( void );
+
+/**
+ * @brief Retrieve the adaptive send chunking state and counters.
+ *
+ * @param[out] pStats Out parameter to provide the state and counters.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetAdaptiveChunkStats( CellularAdaptiveChunkStats_t * pStats );
+
+/**
+ * @brief Retrieve the thermal governor state and counters.
+ *
+ * @param[out] pStats Out parameter to provide the state and counters.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetThermalGovernorStats( CellularThermalGovernorStats_t * pStats );
+
+/**
+ * @brief Retrieve the latency scores of the DNS server candidates.
+ *
+ * @param[out] pScores Array to place the scores, in the order the candidates were set.
+ * @param[in] maxCount Number of entries in pScores.
+ * @param[out] pCount Number of scores placed in pScores.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t CellularModule_GetDnsServerScores( CellularDnsServerScore_t * pScores,
+                                                   uint8_t maxCount,
+                                                   uint8_t * pCount );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_SocketConnect().
+ *        Every AT command timeout used by the call is shortened to the time remaining before deadlineTicks.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle returned from the Cellular_CreateSocket call.
+ * @param[in] dataAccessMode Data access mode of the socket.
+ * @param[in] pRemoteSocketAddress Address (IP and Port) of the remote server to connect to.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_SocketConnectWithDeadline( CellularHandle_t cellularHandle,
+                                                    CellularSocketHandle_t socketHandle,
+                                                    CellularSocketAccessMode_t dataAccessMode,
+                                                    const CellularSocketAddress_t * pRemoteSocketAddress,
+                                                    TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_SocketSend().
+ *        The socket send timeout set through Cellular_SocketSetSockOpt() still applies when it is shorter.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle for which data is to be sent.
+ * @param[in] pData The buffer containing that data to be sent.
+ * @param[in] dataLength The length of the data in the pData.
+ * @param[out] pSentDataLength Out parameter to provide the length of the actual data sent.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_SocketSendWithDeadline( CellularHandle_t cellularHandle,
+                                                 CellularSocketHandle_t socketHandle,
+                                                 const uint8_t * pData,
+                                                 uint32_t dataLength,
+                                                 uint32_t * pSentDataLength,
+                                                 TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_SocketRecv().
+ *        The socket receive timeout set through Cellular_SocketSetSockOpt() still applies when it is shorter.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle for which data is to be received.
+ * @param[out] pBuffer The buffer to receive the data into.
+ * @param[in] bufferLength The length of the buffer pBuffer.
+ * @param[out] pReceivedDataLength Out parameter to provide the length of the actual data received.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_SocketRecvWithDeadline( CellularHandle_t cellularHandle,
+                                                 CellularSocketHandle_t socketHandle,
+                                                 uint8_t * pBuffer,
+                                                 uint32_t bufferLength,
+                                                 uint32_t * pReceivedDataLength,
+                                                 TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_SocketClose().
+ *        An expired deadline is treated like any other close error, so removeSocketOnError still releases the
+ *        socket without sending the close command.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle returned from the Cellular_CreateSocket call.
+ * @param[in] removeSocketOnError Whether to remove the socket data even if closing the socket fails.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_SocketCloseWithDeadline( CellularHandle_t cellularHandle,
+                                                  CellularSocketHandle_t socketHandle,
+                                                  bool removeSocketOnError,
+                                                  TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_ActivatePdn().
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context to activate.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_ActivatePdnWithDeadline( CellularHandle_t cellularHandle,
+                                                  uint8_t contextId,
+                                                  TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_DeactivatePdn().
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context to deactivate.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_DeactivatePdnWithDeadline( CellularHandle_t cellularHandle,
+                                                    uint8_t contextId,
+                                                    TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_GetHostByName().
+ *        Both the AT+QIDNSGIP command and the wait for the +QIURC: "dnsgip" result are bounded by deadlineTicks.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context used for the query.
+ * @param[in] pcHostName The host name to resolve.
+ * @param[out] pResolvedAddress The output parameter to return the resolved IP address.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetHostByNameWithDeadline( CellularHandle_t cellularHandle,
+                                                    uint8_t contextId,
+                                                    const char * pcHostName,
+                                                    char * pResolvedAddress,
+                                                    TickType_t deadlineTicks );
+
+/**
+ * @brief Resolve a host name and return every address reported by the modem, so that a failed connection
+ *        can move on to the next address without another DNS query.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context used for the query.
+ * @param[in] pcHostName The host name to resolve.
+ * @param[out] pResolvedAddresses Array to place the resolved addresses, in the order reported by the modem.
+ * @param[in] maxAddressCount Number of entries in pResolvedAddresses, further addresses are dropped.
+ * @param[out] pAddressCount Number of addresses placed in pResolvedAddresses.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetHostByNameMultiple( CellularHandle_t cellularHandle,
+                                                uint8_t contextId,
+                                                const char * pcHostName,
+                                                CellularIPAddress_t * pResolvedAddresses,
+                                                uint8_t maxAddressCount,
+                                                uint8_t * pAddressCount );
+
+/**
+ * @brief Re-resolve the hot entries of the DNS result cache whose TTL is about to run out, so the next
+ *        Cellular_GetHostByName() of those host names is still answered from the cache.
+ *        Intended to be called periodically from an idle point of the application. The queries use the
+ *        background AT priority class and give way to any other queued request.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ *
+ * @return CELLULAR_SUCCESS if the cache was scanned, a failed refresh is only counted in the DNS cache
+ * statistics. Otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_RefreshDnsCache( CellularHandle_t cellularHandle );
+
+/**
+ * @brief Cellular_GetSimCardInfo() with control over the identity cache. The cached values are dropped on
+ *        the QSIMSTAT, RDY and APP RDY URCs and read again with AT+CIMI, AT+CRSM and AT+QCCID on the next call.
+ *        A SIM swap is only seen through the QSIMSTAT URC, so the cache is only used while the modem reports
+ *        that URC enabled (AT+QSIMSTAT=1).
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pSimCardInfo Out parameter to provide the SIM card information.
+ * @param[in] forceRefresh Read the values from the SIM even if they are cached.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetSimCardInfoWithRefresh( CellularHandle_t cellularHandle,
+                                                    CellularSimCardInfo_t * pSimCardInfo,
+                                                    bool forceRefresh );
+
+/**
+ * @brief Cellular_GetModemInfo() with control over the identity cache. The cached values are dropped on
+ *        the RDY and APP RDY URCs.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pModemInfo Out parameter to provide the modem information.
+ * @param[in] forceRefresh Read the values from the modem even if they are cached.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetModemInfoWithRefresh( CellularHandle_t cellularHandle,
+                                                  CellularModemInfo_t * pModemInfo,
+                                                  bool forceRefresh );
+
+/**
+ * @brief Get the SIM insertion state kept up to date by the QSIMSTAT URC. No AT command is sent while the
+ *        URC is enabled and the state is known, otherwise AT+QSIMSTAT? is polled once.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pSimCardState Out parameter to provide the SIM insertion state.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetTrackedSimCardState( CellularHandle_t cellularHandle,
+                                                 CellularSimCardState_t * pSimCardState );
+
+/**
+ * @brief Enable or disable the QSIMSTAT URC with AT+QSIMSTAT. Enabling reads the current state once.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] enable Report SIM insertion and removal with the URC.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetSimStateUrcEnabled( CellularHandle_t cellularHandle,
+                                                bool enable );
+
+/**
+ * @brief Register a callback for SIM insertion state changes. Pass NULL to remove it.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] simStateChangedCallback Called with the new state, from the URC path or a polling call.
+ * @param[in] pCallbackContext Passed to the callback.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_RegisterUrcSimStateChangedCallback( CellularHandle_t cellularHandle,
+                                                             CellularUrcSimStateChangedCallback_t simStateChangedCallback,
+                                                             void * pCallbackContext );
+
+/**
+ * @brief Cellular_GetLTENetworkInfo() served from the serving cell cache. Tracking area code and cell ID
+ *        follow the CEREG URC, AT+QNWINFO is only sent again after the cell changed. Without a cached
+ *        record both AT+QNWINFO and AT+CEREG? are sent.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pLTENetworkInfo Out parameter to provide the LTE network information.
+ * @param[out] pAgeMs Time since the record was last confirmed by a URC or an AT command. Can be NULL.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetCachedLTENetworkInfo( CellularHandle_t cellularHandle,
+                                                  CellularLTENetworkInfo_t * pLTENetworkInfo,
+                                                  uint32_t * pAgeMs );
+
+/**
+ * @brief Cellular_GetSignalInfo() without the RAT query, two round trips instead of three. The RAT for the
+ *        signal bars is taken from the AT+QCSQ system mode, AT+CSQ only adds the BER and the RSSI fallback.
+ *        The two are not chained into one command: their answers share no prefix but "+", which would also
+ *        take in any URC arriving meanwhile.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pSignalInfo Out parameter to provide the signal information.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetSignalInfoSkipRatQuery( CellularHandle_t cellularHandle,
+                                                    CellularSignalInfo_t * pSignalInfo );
+
+/**
+ * @brief Start or stop recording QIND csq URCs in the signal history. The URC is enabled with
+ *        AT+QINDCFG="csq" while either the history or a signal strength callback needs it.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] enable Record the URC in the signal history.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetSignalHistoryEnabled( CellularHandle_t cellularHandle,
+                                                  bool enable );
+
+/**
+ * @brief Register a callback for PSM timeline changes. Pass NULL to remove it.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] psmTimelineCallback Called with a copy of the updated timeline.
+ * @param[in] pCallbackContext Passed to the callback.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_RegisterPsmTimelineCallback( CellularHandle_t cellularHandle,
+                                                      CellularPsmTimelineCallback_t psmTimelineCallback,
+                                                      void * pCallbackContext );
+
+/**
+ * @brief Send data on a socket, deferring non-urgent data to the modem's next PSM active window.
+ *
+ * Without negotiated PSM timers the data is sent right away. Otherwise non-urgent data is copied to a
+ * queue that Cellular_FlushDeferredSends() sends, a full queue is flushed first. Urgent data is sent right
+ * away together with the queue. A payload the modem takes in parts is sent until all of it is out. The
+ * modem is asked to enter PSM after every flush.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle for sending data.
+ * @param[in] pData The data to send, at most CELLULAR_BG770_DEFERRED_SEND_MAX_DATA_SIZE bytes.
+ * @param[in] dataLength The length of pData.
+ * @param[in] urgent Send now even if that wakes the modem.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SocketSendDeferred( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             const uint8_t * pData,
+                                             uint32_t dataLength,
+                                             bool urgent );
+
+/**
+ * @brief Send the payloads queued by Cellular_SocketSendDeferred() and ask the modem to enter PSM.
+ *
+ * Meant to be called from an application task once the PSM timeline callback reports the modem awake.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] force Flush even outside an active window, waking the modem.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful or there was nothing to do, otherwise the
+ * error of the first failed send.
+ */
+CellularError_t Cellular_FlushDeferredSends( CellularHandle_t cellularHandle,
+                                             bool force );
+
+/**
+ * @brief Ask the modem to enter PSM once it has been idle for a while.
+ *
+ * A monitor thread, started on first use, sends AT+QCFG="psm/enter",1 when PSM timers were negotiated,
+ * no prioritized AT request ran for idleTimeoutMs and no socket has unread data reported by a receive URC.
+ * It asks once per idle period.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] idleTimeoutMs Quiet period before PSM entry is requested, 0 to disable.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetAutoPsmEntry( CellularHandle_t cellularHandle,
+                                          uint32_t idleTimeoutMs );
+
+/**
+ * @brief Read the eDRX parameters the network granted with AT+CEDRXRDP and estimate the paging windows.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pEdrxTimeline Out parameter to provide the parameters and the window estimate.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetNegotiatedEdrx( CellularHandle_t cellularHandle,
+                                            CellularEdrxTimeline_t * pEdrxTimeline );
+
+/**
+ * @brief Block until the modem is estimated to be in an eDRX paging window.
+ *
+ * Meant for operations that need the network to reach the modem, such as a request waiting for its
+ * response. Returns at once without eDRX, or before Cellular_GetNegotiatedEdrx() was called and a
+ * receive URC anchored the windows.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] maxWaitMs Longest time to wait.
+ *
+ * @return CELLULAR_SUCCESS inside a window, CELLULAR_TIMEOUT if the next window is further away than
+ * maxWaitMs, after waiting maxWaitMs, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_WaitForPagingWindow( CellularHandle_t cellularHandle,
+                                              uint32_t maxWaitMs );
+
+/**
+ * @brief Sample signal, temperatures, LTE network info and service status periodically.
+ *
+ * A monitor thread, started on first use, runs the four queries back to back at background priority
+ * and publishes them as one CellularHealthSnapshot_t. A pass is skipped while the modem is in PSM or a
+ * data transfer is active, the snapshot keeps its previous values and counts the skip.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] periodMs Time between passes, 0 to pause the monitor.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetHealthMonitorPeriod( CellularHandle_t cellularHandle,
+                                                 uint32_t periodMs );
+
+/**
+ * @brief Enable or disable adaptive chunking of socket sends.
+ *
+ * When enabled, each AT+QISEND carries at most the current chunk size. The chunk size is also bounded by the
+ * latest RSRP and SINR read with AT+QCSQ. It grows additively after prompt full chunks and halves after
+ * slow or failed sends. The caller sees a short send as with any partial send. Enabling resets the counters.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] enable true to enable, false to send CELLULAR_MAX_SEND_DATA_LEN chunks again.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetAdaptiveChunking( CellularHandle_t cellularHandle,
+                                              bool enable );
+
+/**
+ * @brief Enable or disable the thermal governor of socket sends.
+ *
+ * While a transfer is active the modem temperature is read every sampleIntervalMs before a send. Above a
+ * threshold each send is cut to the step's chunk size and delayed by the step's delay, the caller sees a
+ * short send as with any partial send.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] pConfig The settings, NULL to disable the governor.
+ * @param[in] stepCallback Called on every step change, can be NULL.
+ * @param[in] pCallbackContext Passed to the callback.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetThermalGovernor( CellularHandle_t cellularHandle,
+                                             const CellularThermalGovernorConfig_t * pConfig,
+                                             CellularThermalStepCallback_t stepCallback,
+                                             void * pCallbackContext );
+
+/**
+ * @brief Set the DNS servers Cellular_ProbeDnsServers() chooses from and reset their scores.
+ *        The modem configuration is not changed until the next probe.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context the servers are configured for.
+ * @param[in] ppServerAddresses Server IP addresses, in order of preference until the first probe.
+ * @param[in] serverCount Number of entries in ppServerAddresses, at most CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_NOT_ALLOWED while a probe is running,
+ * otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetDnsCandidates( CellularHandle_t cellularHandle,
+                                           uint8_t contextId,
+                                           const char * const * ppServerAddresses,
+                                           uint8_t serverCount );
+
+/**
+ * @brief Time an uncached AT+QIDNSGIP of pProbeHostName against each candidate DNS server, update the moving
+ *        latency scores and program AT+QIDNSCFG with the fastest pair when the scores have drifted far enough.
+ *        Each candidate is programmed alone while it is probed, call this from an idle point of the application.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] pProbeHostName Host name resolved through every candidate.
+ *
+ * @return CELLULAR_SUCCESS if the selected servers were programmed, CELLULAR_NOT_ALLOWED if a probe is already
+ * running, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_ProbeDnsServers( CellularHandle_t cellularHandle,
+                                          const char * pProbeHostName );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_GetServiceSelection().
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pServiceSelection Pointer to memory to place the current service selection.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_GetServiceSelectionWithDeadline( CellularHandle_t cellularHandle,
+                                                          CellularServiceSelection_t * pServiceSelection,
+                                                          TickType_t deadlineTicks );
+
+/**
+ * @brief Deadline-bounded variant of Cellular_SetServiceSelection().
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] pServiceSelection The service selection (registration mode, operator and RAT) to apply.
+ * @param[in] deadlineTicks Absolute CellularModule_GetTicks() tick count by which the call must complete.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_TIMEOUT if the deadline expired before or
+ * during the operation, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_SetServiceSelectionWithDeadline( CellularHandle_t cellularHandle,
+                                                          const CellularServiceSelection_t *const pServiceSelection,
+                                                          TickType_t deadlineTicks );
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
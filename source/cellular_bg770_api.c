@@ -64,6 +64,11 @@
 
 /* AT command timeout for Get IP Address by Domain Name. */
 #define DNS_QUERY_TIMEOUT_MS                       ( 60000UL )
+#define DNS_QUERY_SLOT_RETRY_PERIOD_ticks          ( pdMS_TO_TICKS( 100U ) )
+#define DNS_QUERY_ABANDONED_MAX_AGE_ticks          ( pdMS_TO_TICKS( 2U * DNS_QUERY_TIMEOUT_MS ) )
+
+/* Weight of the previous DNS server latency score, a new probe contributes 1 / DNS_SERVER_SCORE_WEIGHT. */
+#define DNS_SERVER_SCORE_WEIGHT                    ( 4U )
 
 /* Length of HPLMN including RAT. */
 #define CRSM_HPLMN_RAT_LENGTH                      ( 9U )
@@ -96,6 +101,11 @@
 #define CELLULAR_PDN_STATUS_POS_CONTEXT_TYPE     ( 2U )
 #define CELLULAR_PDN_STATUS_POS_IP_ADDRESS       ( 3U )
 
+#define EDRX_ACT_TYPE_NOT_USED                   ( 0 )
+#define EDRX_ACT_TYPE_NB_S1                      ( 5 )
+#define EDRX_PTW_UNIT_WB_S1_MS                   ( 1280U )
+#define EDRX_PTW_UNIT_NB_S1_MS                   ( 2560U )
+
 #define RAT_PRIORITY_STRING_LENGTH               ( 2U )
 #define RAT_PRIORITY_LIST_LENGTH                 ( 3U )
 
@@ -123,6 +133,13 @@
 
 /*-----------------------------------------------------------*/
 
+/* eDRX cycle length of each 4 bit eDRX value, 3GPP TS 24.008 table 10.5.5.32. */
+static const uint32_t EDRX_CYCLE_MS[ 16 ] =
+{
+    5120U, 10240U, 20480U, 40960U, 61440U, 81920U, 102400U, 122880U,
+    143360U, 163840U, 327680U, 655360U, 1310720U, 2621440U, 5242880U, 10485760U
+};
+
 static const int FLOW_CONTROL_NONE = 0;
 static const int RTS_FLOW_CONTROL_ENABLED = 2;
 static const int CTS_FLOW_CONTROL_ENABLED = 2;
@@ -145,6 +162,27 @@ typedef struct _bg770FrequencyBands
     char nbIotBands_hexString[BG770_NB_IOT_BAND_HEX_STRING_MAX_LENGTH + 1];
 } _bg770FrequencyBands_t;
 
+/**
+ * @brief Responses of AT+QCSQ and AT+CSQ.
+ */
+typedef struct _combinedSignalInfo
+{
+    CellularSignalInfo_t signalInfo;
+    CellularSignalInfo_t csqSignalInfo;
+    CellularRat_t rat;
+    bool qcsqParsed;
+    bool csqParsed;
+} _combinedSignalInfo_t;
+
+/**
+ * @brief Response of AT+QSIMSTAT?.
+ */
+typedef struct _simStat
+{
+    CellularSimCardState_t simCardState;
+    bool urcEnabled;
+} _simStat_t;
+
 /*-----------------------------------------------------------*/
 
 static bool _parseSignalQuality( char * pQcsqPayload,
@@ -249,9 +287,67 @@ static CellularError_t storeAccessModeAndAddress( CellularContext_t * pContext,
 static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModuleContext,
                                                  CellularDnsResultEventCallback_t dnsEventCallback,
                                                  char * pDnsUsrData );
+static cellularDnsQuery_t * _getOldestPendingDnsQuery( cellularModuleContext_t * pModuleContext );
+static void _dropAbandonedDnsQueries( cellularModuleContext_t * pModuleContext );
+static void _completeDnsQuery( cellularDnsQuery_t * pQuery,
+                               cellularDnsQueryResult_t dnsQueryResult );
+static CellularError_t _claimDnsQuery( cellularModuleContext_t * pModuleContext,
+                                       const TickType_t * pDeadlineTicks,
+                                       cellularDnsQuery_t ** ppQuery );
+static void _releaseDnsQuery( cellularModuleContext_t * pModuleContext,
+                              cellularDnsQuery_t * pQuery );
+static void _storeDnsResultAddress( CellularIPAddress_t * pAddress,
+                                    const char * pDnsResultStr );
+static void _updateDnsServerScore( CellularDnsServerScore_t * pScore,
+                                   bool probeSucceeded,
+                                   uint32_t latencyMs );
+static void _selectDnsServers( cellularModuleContext_t * pModuleContext );
+static CellularError_t _Cellular_GetSimCardInfo( CellularContext_t * pContext,
+                                                 CellularSimCardInfo_t * pSimCardInfo,
+                                                 bool forceRefresh );
+static CellularError_t _Cellular_GetModemInfo( CellularContext_t * pContext,
+                                               CellularModemInfo_t * pModemInfo,
+                                               bool forceRefresh );
 static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
                                 char * pDnsResult,
                                 char * pDnsUsrData );
+static bool _isPsmActiveWindowOpen( cellularModuleContext_t * pModuleContext,
+                                    bool * pPsmNegotiated,
+                                    uint32_t * pWakeCostMs );
+static CellularError_t _sendDeferredPayload( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             const uint8_t * pData,
+                                             uint32_t dataLength );
+static CellularError_t _flushDeferredSends( CellularContext_t * pContext,
+                                            cellularModuleContext_t * pModuleContext,
+                                            bool inActiveWindow );
+static void _purgeDeferredSends( cellularModuleContext_t * pModuleContext,
+                                 CellularSocketHandle_t socketHandle );
+static void _adaptiveChunkNoteSignal( const CellularContext_t * pContext,
+                                      const CellularSignalInfo_t * pSignalInfo );
+static uint32_t _getSignalChunkCap( int16_t rsrp,
+                                    int16_t sinr );
+static uint32_t _getAdaptiveChunkSize( CellularContext_t * pContext,
+                                       uint32_t dataLength );
+static void _adaptiveChunkFeedback( CellularContext_t * pContext,
+                                    uint32_t chunkLength,
+                                    uint32_t sentLength,
+                                    bool sendSucceeded,
+                                    uint32_t elapsedMs );
+static int16_t _getHottestTemperature( const CellularTemperatures_t * pTemperatures );
+static uint32_t _applyThermalGovernor( CellularContext_t * pContext,
+                                       uint32_t dataLength,
+                                       const TickType_t * pDeadlineTicks );
+static uint32_t _getEdrxCycleMs( uint8_t actType,
+                                 uint8_t edrxValue );
+static bool _parseEdrxRdp( char * pEdrxRdpPayload,
+                           CellularEdrxTimeline_t * pEdrxTimeline );
+static CellularPktStatus_t _Cellular_RecvFuncGetEdrxRdp( CellularContext_t * pContext,
+                                                         const CellularATCommandResponse_t * pAtResp,
+                                                         void * pData,
+                                                         uint16_t dataLen );
+static uint32_t _getPagingWindowWaitMs( CellularEdrxTimeline_t * pEdrxTimeline,
+                                        TickType_t nowTicks );
 static uint32_t appendBinaryPattern( char * cmdBuf,
                                      uint32_t cmdLen,
                                      uint32_t value,
@@ -259,6 +355,145 @@ static uint32_t appendBinaryPattern( char * cmdBuf,
 static CellularPktStatus_t socketSendDataPrefix( void * pCallbackContext,
                                                  char * pLine,
                                                  uint32_t * pBytesRead );
+static CellularError_t _getDeadlineBoundedTimeoutMs( const TickType_t * pDeadlineTicks,
+                                                     uint32_t timeoutMs,
+                                                     uint32_t * pBoundedTimeoutMs );
+static CellularPktStatus_t _priorityTimeoutAtcmdRequestWithCallback( CellularContext_t * pContext,
+                                                                     CellularAtPriorityClass_t priorityClass,
+                                                                     CellularAtReq_t atReq,
+                                                                     uint32_t timeoutMs,
+                                                                     const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_DeactivatePdn( CellularContext_t * pContext,
+                                                uint8_t contextId,
+                                                const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_ActivatePdn( CellularContext_t * pContext,
+                                              uint8_t contextId,
+                                              const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_SocketRecv( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             uint8_t * pBuffer,
+                                             uint32_t bufferLength,
+                                             uint32_t * pReceivedDataLength,
+                                             const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_SocketSend( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             const uint8_t * pData,
+                                             uint32_t dataLength,
+                                             uint32_t * pSentDataLength,
+                                             const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_SocketClose( CellularContext_t * pContext,
+                                              CellularSocketHandle_t socketHandle,
+                                              bool removeSocketOnError,
+                                              const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_SocketConnect( CellularContext_t * pContext,
+                                                CellularSocketHandle_t socketHandle,
+                                                CellularSocketAccessMode_t dataAccessMode,
+                                                const CellularSocketAddress_t * pRemoteSocketAddress,
+                                                const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_GetHostByName( CellularContext_t * pContext,
+                                                uint8_t contextId,
+                                                const char * pcHostName,
+                                                char * pResolvedAddress,
+                                                CellularIPAddress_t * pResolvedAddresses,
+                                                uint8_t maxAddressCount,
+                                                uint8_t * pAddressCount,
+                                                CellularAtPriorityClass_t priorityClass,
+                                                bool useCache,
+                                                const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_GetServiceSelection( CellularContext_t * pContext,
+                                                      CellularServiceSelection_t * pServiceSelection,
+                                                      const TickType_t * pDeadlineTicks );
+static CellularError_t _Cellular_SetServiceSelection( CellularContext_t * pContext,
+                                                      const CellularServiceSelection_t * pServiceSelection,
+                                                      const TickType_t * pDeadlineTicks );
+
+/*-----------------------------------------------------------*/
+
+/* Bound an AT command timeout to the time left before an absolute tick deadline.
+ * A NULL deadline leaves the timeout untouched; an expired deadline fails with
+ * CELLULAR_TIMEOUT so that no AT command is issued. */
+static CellularError_t _getDeadlineBoundedTimeoutMs( const TickType_t * pDeadlineTicks,
+                                                     uint32_t timeoutMs,
+                                                     uint32_t * pBoundedTimeoutMs )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    TickType_t remainingTicks = 0;
+    uint64_t remainingMs = 0;
+
+    if( pDeadlineTicks == NULL )
+    {
+        *pBoundedTimeoutMs = timeoutMs;
+    }
+    else
+    {
+        /* Tick arithmetic wraps, a deadline more than half the tick range away is treated as already passed. */
+        remainingTicks = *pDeadlineTicks - _Cellular_GetTicks();
+
+        if( ( remainingTicks == 0U ) || ( remainingTicks > ( portMAX_DELAY / 2U ) ) )
+        {
+            LogWarn( ( "_getDeadlineBoundedTimeoutMs: deadline expired" ) );
+            cellularStatus = CELLULAR_TIMEOUT;
+        }
+        else
+        {
+            remainingMs = ( ( uint64_t ) remainingTicks * 1000U ) / ( uint64_t ) configTICK_RATE_HZ;
+
+            if( remainingMs == 0U )
+            {
+                cellularStatus = CELLULAR_TIMEOUT;
+            }
+            else if( remainingMs < ( uint64_t ) timeoutMs )
+            {
+                *pBoundedTimeoutMs = ( uint32_t ) remainingMs;
+            }
+            else
+            {
+                *pBoundedTimeoutMs = timeoutMs;
+            }
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Send an AT request once its priority lane lets it ahead of queued lower classes. With a deadline, the
+ * time spent queued comes out of timeoutMs and a deadline expiring in the queue sends nothing. */
+static CellularPktStatus_t _priorityTimeoutAtcmdRequestWithCallback( CellularContext_t * pContext,
+                                                                     CellularAtPriorityClass_t priorityClass,
+                                                                     CellularAtReq_t atReq,
+                                                                     uint32_t timeoutMs,
+                                                                     const TickType_t * pDeadlineTicks )
+{
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t boundedTimeoutMs = timeoutMs;
+    bool atPriorityAcquired = false;
+
+    cellularStatus = _Cellular_AtPriorityAcquire( pContext, priorityClass, pDeadlineTicks, &atPriorityAcquired );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &boundedTimeoutMs );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReq, boundedTimeoutMs );
+    }
+    else
+    {
+        pktStatus = CELLULAR_PKT_STATUS_TIMED_OUT;
+    }
+
+    if( atPriorityAcquired )
+    {
+        _Cellular_AtPriorityRelease( pContext );
+    }
+
+    return pktStatus;
+}
 
 /*-----------------------------------------------------------*/
 
@@ -436,6 +671,10 @@ static CellularPktStatus_t _Cellular_RecvFuncGetQuectelSignalInfo( CellularConte
             pSignalInfo->bars = CELLULAR_INVALID_SIGNAL_BAR_VALUE;
             pktStatus = CELLULAR_PKT_STATUS_FAILURE;
         }
+        else
+        {
+            _adaptiveChunkNoteSignal( pContext, pSignalInfo );
+        }
     }
 
     return pktStatus;
@@ -958,7 +1197,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSimCardStatus( CellularContext_t
     const char * pTokenPtr = NULL;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
-    CellularSimCardState_t * pSimCardState = ( CellularSimCardState_t * ) pData;
+    _simStat_t * pSimStat = ( _simStat_t * ) pData;
 
     if( pContext == NULL )
     {
@@ -969,7 +1208,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSimCardStatus( CellularContext_t
         LogError( ( "GetSimStatus: response is invalid" ) );
         pktStatus = CELLULAR_PKT_STATUS_FAILURE;
     }
-    else if( ( pData == NULL ) || ( dataLen != sizeof( CellularSimCardState_t ) ) )
+    else if( ( pData == NULL ) || ( dataLen != sizeof( _simStat_t ) ) )
     {
         pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
     }
@@ -991,7 +1230,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSimCardStatus( CellularContext_t
             }
             else
             {
-                pktStatus = _Cellular_ParseSimstat( pInputLine, pSimCardState );
+                pktStatus = _Cellular_ParseSimstat( pInputLine, &pSimStat->simCardState, &pSimStat->urcEnabled );
             }
         }
     }
@@ -2276,6 +2515,202 @@ static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModu
 
 /*-----------------------------------------------------------*/
 
+/* Must be called with dnsPendingMutex held. The modem answers AT+QIDNSGIP in the order it receives them,
+ * so a "dnsgip" URC belongs to the pending query sent first. */
+static cellularDnsQuery_t * _getOldestPendingDnsQuery( cellularModuleContext_t * pModuleContext )
+{
+    cellularDnsQuery_t * pOldestQuery = NULL;
+    uint32_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES; i++ )
+    {
+        if( ( pModuleContext->dnsQueries[ i ].pending ) &&
+            ( ( pOldestQuery == NULL ) || ( pModuleContext->dnsQueries[ i ].sequence < pOldestQuery->sequence ) ) )
+        {
+            pOldestQuery = &pModuleContext->dnsQueries[ i ];
+        }
+    }
+
+    return pOldestQuery;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Must be called with dnsPendingMutex held. The URC of an abandoned query that never came would take
+ * the result of the next query, stop expecting it. */
+static void _dropAbandonedDnsQueries( cellularModuleContext_t * pModuleContext )
+{
+    const TickType_t nowTicks = _Cellular_GetTicks();
+    uint32_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES; i++ )
+    {
+        if( ( pModuleContext->dnsQueries[ i ].owned == false ) && ( pModuleContext->dnsQueries[ i ].pending ) &&
+            ( ( nowTicks - pModuleContext->dnsQueries[ i ].sentTicks ) > DNS_QUERY_ABANDONED_MAX_AGE_ticks ) )
+        {
+            LogWarn( ( "_dropAbandonedDnsQueries: dropping abandoned DNS query %lu", pModuleContext->dnsQueries[ i ].sequence ) );
+            pModuleContext->dnsQueries[ i ].pending = false;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Must be called with dnsPendingMutex held. Wakes the requester once, after that the result buffers
+ * belong to the requester again and are no longer written. */
+static void _completeDnsQuery( cellularDnsQuery_t * pQuery,
+                               cellularDnsQueryResult_t dnsQueryResult )
+{
+    cellularDnsQueryCompletion_t completion = { 0 };
+
+    if( ( pQuery->owned ) && ( pQuery->completed == false ) )
+    {
+        completion.result = dnsQueryResult;
+        completion.timeToLiveSeconds = pQuery->timeToLiveSeconds;
+        completion.addressCount = pQuery->resolvedAddressCount;
+        completion.resultCode = pQuery->resultCode;
+        pQuery->completed = true;
+
+        if( xQueueSend( pQuery->resultQueue, &completion, ( TickType_t ) 0 ) != pdPASS )
+        {
+            LogError( ( "_completeDnsQuery resultQueue send fail, result: %d", dnsQueryResult ) );
+        }
+    }
+
+    pQuery->pResolvedAddress = NULL;
+    pQuery->pResolvedAddresses = NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Claim a free query slot. On success dnsQueryMutex is held, it is released once AT+QIDNSGIP is sent so
+ * the order of the pending queries matches the order the modem sees. */
+static CellularError_t _claimDnsQuery( cellularModuleContext_t * pModuleContext,
+                                       const TickType_t * pDeadlineTicks,
+                                       cellularDnsQuery_t ** ppQuery )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularDnsQuery_t * pQuery = NULL;
+    const TickType_t startTicks = _Cellular_GetTicks();
+    uint32_t waitTimeoutMs = DNS_QUERY_TIMEOUT_MS;
+    uint32_t i = 0;
+
+    cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, waitTimeoutMs, &waitTimeoutMs );
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( pQuery == NULL ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+        PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
+        _dropAbandonedDnsQueries( pModuleContext );
+
+        for( i = 0; ( pQuery == NULL ) && ( i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES ); i++ )
+        {
+            if( ( pModuleContext->dnsQueries[ i ].owned == false ) && ( pModuleContext->dnsQueries[ i ].pending == false ) )
+            {
+                pQuery = &pModuleContext->dnsQueries[ i ];
+                pQuery->owned = true;
+                pQuery->completed = false;
+                pQuery->resultNumber = 0;
+                pQuery->resultIndex = 0;
+                pQuery->timeToLiveSeconds = 0;
+                pQuery->resultCode = -1;
+                pQuery->pResolvedAddress = NULL;
+                pQuery->pResolvedAddresses = NULL;
+                pQuery->resolvedAddressesMax = 0;
+                pQuery->resolvedAddressCount = 0;
+                ( void ) xQueueReset( pQuery->resultQueue );
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
+
+        if( pQuery == NULL )
+        {
+            PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+            if( ( _Cellular_GetTicks() - startTicks ) >= pdMS_TO_TICKS( waitTimeoutMs ) )
+            {
+                LogWarn( ( "_claimDnsQuery: all %u DNS query slots busy", CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES ) );
+                cellularStatus = CELLULAR_TIMEOUT;
+            }
+            else
+            {
+                _Cellular_DelayTicks( DNS_QUERY_SLOT_RETRY_PERIOD_ticks );
+            }
+        }
+    }
+
+    *ppQuery = pQuery;
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _releaseDnsQuery( cellularModuleContext_t * pModuleContext,
+                              cellularDnsQuery_t * pQuery )
+{
+    PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
+
+    if( pQuery->pending )
+    {
+        /* The URC is still consumed by this slot so that later queries stay matched. */
+        LogWarn( ( "_releaseDnsQuery: DNS query %lu abandoned before its result", pQuery->sequence ) );
+    }
+
+    pQuery->owned = false;
+    pQuery->pResolvedAddress = NULL;
+    pQuery->pResolvedAddresses = NULL;
+
+    PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The modem forgets its AT+QIDNSGIP queries when it restarts or the PDN goes down, no URC follows for them.
+ * Their requesters are failed now, left pending they would take the results of later queries.
+ * A contextId of 0 aborts the queries of every context. */
+void _Cellular_DnsQueriesAbort( cellularModuleContext_t * pModuleContext,
+                                uint8_t contextId )
+{
+    uint32_t i = 0;
+
+    PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
+
+    for( i = 0; i < CELLULAR_BG770_DNS_MAX_CONCURRENT_QUERIES; i++ )
+    {
+        if( ( pModuleContext->dnsQueries[ i ].pending ) &&
+            ( ( contextId == 0U ) || ( pModuleContext->dnsQueries[ i ].contextId == contextId ) ) )
+        {
+            LogWarn( ( "_Cellular_DnsQueriesAbort: DNS query %lu aborted", pModuleContext->dnsQueries[ i ].sequence ) );
+            _completeDnsQuery( &pModuleContext->dnsQueries[ i ], CELLULAR_DNS_QUERY_FAILED );
+            pModuleContext->dnsQueries[ i ].pending = false;
+        }
+    }
+
+    PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
+}
+
+/*-----------------------------------------------------------*/
+
+static void _storeDnsResultAddress( CellularIPAddress_t * pAddress,
+                                    const char * pDnsResultStr )
+{
+    ( void ) strncpy( pAddress->ipAddress, pDnsResultStr, CELLULAR_IP_ADDRESS_MAX_SIZE );
+    pAddress->ipAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE ] = '\0';
+
+    if( strchr( pAddress->ipAddress, ':' ) != NULL )
+    {
+        pAddress->ipAddressType = CELLULAR_IP_ADDRESS_V6;
+    }
+    else
+    {
+        pAddress->ipAddressType = CELLULAR_IP_ADDRESS_V4;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
                                 char * pDnsResult,
                                 char * pDnsUsrData )
@@ -2284,11 +2719,22 @@ static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
     CellularATError_t atCoreStatusNonCritical = CELLULAR_AT_SUCCESS;
     char * pToken = NULL, * pDnsResultStr = pDnsResult;
     int32_t dnsResultCode = -1, dnsResultNumber = -1, dnsTimeToLiveSeconds = -1;    // negative values to indicate never set
-    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    cellularDnsQuery_t * pQuery = NULL;
+
+    /* Results are matched to queries by order, the per query user data is not used. */
+    ( void ) pDnsUsrData;
 
     if( pModuleContext != NULL )
     {
-        if( pModuleContext->dnsResultNumber == ( uint8_t ) 0 )
+        PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
+        _dropAbandonedDnsQueries( pModuleContext );
+        pQuery = _getOldestPendingDnsQuery( pModuleContext );
+
+        if( pQuery == NULL )
+        {
+            LogWarn( ( "_dnsResultCallback spurious DNS response" ) );
+        }
+        else if( pQuery->resultNumber == ( uint8_t ) 0 )
         {
             atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
 
@@ -2299,6 +2745,8 @@ static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
                 /* dnsResultCode of 0 indicates successful operation */
                 if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsResultCode >= 0 ) )
                 {
+                    pQuery->resultCode = dnsResultCode;
+
                     if( dnsResultCode != 0 )
                     {
                         atCoreStatus = CELLULAR_AT_ERROR;
@@ -2324,9 +2772,9 @@ static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
                 if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsResultNumber >= 0 ) &&
                     ( dnsResultNumber <= ( int32_t ) UINT8_MAX ) )
                 {
-                    pModuleContext->dnsResultNumber = ( uint8_t ) dnsResultNumber;
+                    pQuery->resultNumber = ( uint8_t ) dnsResultNumber;
                     /* dnsResultNumber of zero indicates no further response, indicate query unsuccessful */
-                    if( pModuleContext->dnsResultNumber == 0 )
+                    if( pQuery->resultNumber == 0 )
                     {
                         atCoreStatus = CELLULAR_AT_ERROR;
                         LogWarn( ( "_dnsResultCallback IP count is zero, no DNS result" ) );
@@ -2347,8 +2795,9 @@ static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
                 {
                     atCoreStatusNonCritical = Cellular_ATStrtoi( pToken, 10, &dnsTimeToLiveSeconds );
 
-                    if( atCoreStatusNonCritical == CELLULAR_AT_SUCCESS )
+                    if( ( atCoreStatusNonCritical == CELLULAR_AT_SUCCESS ) && ( dnsTimeToLiveSeconds >= 0 ) )
                     {
+                        pQuery->timeToLiveSeconds = ( uint32_t ) dnsTimeToLiveSeconds;
                         // FUTURE: Lower this to debug level
                         LogInfo( ( "_dnsResultCallback result code: %ld, ip count: %ld, ttl: %ld s.",
                                    dnsResultCode, dnsResultNumber, dnsTimeToLiveSeconds ) );
@@ -2365,34 +2814,50 @@ static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
                 LogError( ( "_dnsResultCallback error, err: %d, result code: %ld, ip count: %ld, ttl: %ld s.",
                             atCoreStatus, dnsResultCode, dnsResultNumber, dnsTimeToLiveSeconds ) );
 
-                pDnsUsrData[0] = '\0';  // explicit indication of empty IP address string
-                ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-                dnsQueryResult = CELLULAR_DNS_QUERY_FAILED;
-
-                /* send explicit failure instead of only relying on DNS request timeout */
-                if( xQueueSend( pModuleContext->pktDnsQueue, &dnsQueryResult, ( TickType_t ) 0 ) != pdPASS )
+                if( pQuery->pResolvedAddress != NULL )
                 {
-                    LogError( ( "_dnsResultCallback pktDnsQueue send fail on DNS query failure" ) );
+                    pQuery->pResolvedAddress[0] = '\0';  // explicit indication of empty IP address string
                 }
+
+                /* send explicit failure instead of only relying on DNS request timeout */
+                _completeDnsQuery( pQuery, CELLULAR_DNS_QUERY_FAILED );
+                pQuery->pending = false;
             }
         }
-        else if( ( pModuleContext->dnsIndex < pModuleContext->dnsResultNumber ) && ( pDnsResultStr != NULL ) )
+        else if( ( pQuery->resultIndex < pQuery->resultNumber ) && ( pDnsResultStr != NULL ) )
         {
-            pModuleContext->dnsIndex = pModuleContext->dnsIndex + ( uint8_t ) 1;
+            pQuery->resultIndex = pQuery->resultIndex + ( uint8_t ) 1;
 
-            ( void ) strncpy( pDnsUsrData, pDnsResultStr, CELLULAR_IP_ADDRESS_MAX_SIZE );
-            ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-            dnsQueryResult = CELLULAR_DNS_QUERY_SUCCESS;
+            if( pQuery->pResolvedAddress != NULL )
+            {
+                /* Single result query, the requester is released on the first address. */
+                ( void ) strncpy( pQuery->pResolvedAddress, pDnsResultStr, CELLULAR_IP_ADDRESS_MAX_SIZE );
+                _completeDnsQuery( pQuery, CELLULAR_DNS_QUERY_SUCCESS );
+            }
+            else if( ( pQuery->pResolvedAddresses != NULL ) &&
+                     ( pQuery->resolvedAddressCount < pQuery->resolvedAddressesMax ) )
+            {
+                _storeDnsResultAddress( &pQuery->pResolvedAddresses[ pQuery->resolvedAddressCount ], pDnsResultStr );
+                pQuery->resolvedAddressCount = pQuery->resolvedAddressCount + ( uint8_t ) 1;
+            }
+            else
+            {
+                /* Address not wanted, or the requester already gave up. */
+            }
 
-            if( xQueueSend( pModuleContext->pktDnsQueue, &dnsQueryResult, ( TickType_t ) 0 ) != pdPASS )
+            /* The query stays at the head until every address line is consumed, the next line belongs to it. */
+            if( pQuery->resultIndex >= pQuery->resultNumber )
             {
-                LogError( ( "_dnsResultCallback pktDnsQueue send fail on successful DNS query result" ) );
+                _completeDnsQuery( pQuery, CELLULAR_DNS_QUERY_SUCCESS );
+                pQuery->pending = false;
             }
         }
         else
         {
             LogWarn( ( "_dnsResultCallback spurious DNS response" ) );
         }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
     }
 }
 
@@ -2915,15 +3380,15 @@ CellularError_t Cellular_SetPsmConfigSettings( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
-                                        uint8_t contextId )
+static CellularError_t _Cellular_DeactivatePdn( CellularContext_t * pContext,
+                                                uint8_t contextId,
+                                                const TickType_t * pDeadlineTicks )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t timeoutMs = PDN_DEACTIVATION_PACKET_REQ_TIMEOUT_MS;
     char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularModuleContext_t * pModuleContext = NULL;
     CellularAtReq_t atReqDeactPdn =
     {
         cmdBuf,
@@ -2942,6 +3407,11 @@ CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
         cellularStatus = _Cellular_CheckLibraryStatus( pContext );
     }
 
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &timeoutMs );
+    }
+
     if( cellularStatus == CELLULAR_SUCCESS )
     {
         /* Form the AT command. */
@@ -2950,13 +3420,22 @@ CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
          * The max length of the string is fixed and checked offline. */
         /* coverity[misra_c_2012_rule_21_6_violation]. */
         ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%d", "AT+QIDEACT=", contextId );
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqDeactPdn, PDN_DEACTIVATION_PACKET_REQ_TIMEOUT_MS );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_CONTROL, atReqDeactPdn, timeoutMs, pDeadlineTicks );
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
             LogError( ( "Cellular_DeactivatePdn: can't deactivate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
             cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
         }
+        else if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            /* Results resolved through this PDN may not be valid on the next activation. */
+            _Cellular_DnsCacheInvalidate( pModuleContext, contextId );
+        }
+        else
+        {
+            LogWarn( ( "Cellular_DeactivatePdn: DNS cache not invalidated, no module context" ) );
+        }
     }
 
     return cellularStatus;
@@ -2966,12 +3445,31 @@ CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
-                                      uint8_t contextId )
+CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
+                                        uint8_t contextId )
+{
+    return _Cellular_DeactivatePdn( ( CellularContext_t * ) cellularHandle, contextId, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_DeactivatePdnWithDeadline( CellularHandle_t cellularHandle,
+                                                    uint8_t contextId,
+                                                    TickType_t deadlineTicks )
+{
+    return _Cellular_DeactivatePdn( ( CellularContext_t * ) cellularHandle, contextId, &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_ActivatePdn( CellularContext_t * pContext,
+                                              uint8_t contextId,
+                                              const TickType_t * pDeadlineTicks )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t timeoutMs = PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS;
     char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
 
     CellularAtReq_t atReqActPdn =
@@ -2992,6 +3490,11 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
         cellularStatus = _Cellular_CheckLibraryStatus( pContext );
     }
 
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &timeoutMs );
+    }
+
     if( cellularStatus == CELLULAR_SUCCESS )
     {
         /* Form the AT command. */
@@ -3000,7 +3503,7 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
          * The max length of the string is fixed and checked offline. */
         /* coverity[misra_c_2012_rule_21_6_violation]. */
         ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%d", "AT+QIACT=", contextId );
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqActPdn, PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_DATA, atReqActPdn, timeoutMs, pDeadlineTicks );
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
@@ -3014,6 +3517,26 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
+                                      uint8_t contextId )
+{
+    return _Cellular_ActivatePdn( ( CellularContext_t * ) cellularHandle, contextId, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_ActivatePdnWithDeadline( CellularHandle_t cellularHandle,
+                                                  uint8_t contextId,
+                                                  TickType_t deadlineTicks )
+{
+    return _Cellular_ActivatePdn( ( CellularContext_t * ) cellularHandle, contextId, &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
 static bool _parsePdnConfig( char * pPdnConfigPayload,
                              CellularPdnConfig_t * pPdnConfig )
 {
@@ -3410,7 +3933,8 @@ CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQuerySignalInfo );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqQuerySignalInfo,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
 
         if( pktStatus == CELLULAR_PKT_STATUS_OK )
         {
@@ -3431,7 +3955,8 @@ CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
         atReqQuerySignalInfo.pData = &signalInfo2;
         atReqQuerySignalInfo.dataLen = sizeof( signalInfo2 );
 
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQuerySignalInfo );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqQuerySignalInfo,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
 
         if( pktStatus == CELLULAR_PKT_STATUS_OK )
         {
@@ -3450,23 +3975,175 @@ CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
+/* Parses the answer of AT+QCSQ or AT+CSQ, each is sent with its own prefix so URCs never reach here. */
+/* FreeRTOS Cellular Library types. */
 /* coverity[misra_c_2012_rule_8_13_violation] */
-CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
-                                     CellularSocketHandle_t socketHandle,
-                                     /* coverity[misra_c_2012_rule_8_13_violation] */
-                                     uint8_t * pBuffer,
-                                     uint32_t bufferLength,
-                                     /* coverity[misra_c_2012_rule_8_13_violation] */
-                                     uint32_t * pReceivedDataLength )
+static CellularPktStatus_t _Cellular_RecvFuncGetCombinedSignalInfo( CellularContext_t * pContext,
+                                                                    const CellularATCommandResponse_t * pAtResp,
+                                                                    void * pData,
+                                                                    uint16_t dataLen )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    char * pInputLine = NULL;
+    _combinedSignalInfo_t * pCombinedInfo = ( _combinedSignalInfo_t * ) pData;
+    bool isQcsq = false;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    uint32_t recvTimeout = DATA_READ_TIMEOUT_MS;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+
+    if( pContext == NULL )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+    }
+    else if( ( pCombinedInfo == NULL ) || ( dataLen != sizeof( _combinedSignalInfo_t ) ) )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else if( ( pAtResp == NULL ) || ( pAtResp->pItm == NULL ) || ( pAtResp->pItm->pLine == NULL ) )
+    {
+        LogError( ( "GetCombinedSignalInfo: Input Line passed is NULL" ) );
+        pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+    }
+    else
+    {
+        pInputLine = pAtResp->pItm->pLine;
+        isQcsq = ( strncmp( pInputLine, "+QCSQ", 5 ) == 0 );
+        atCoreStatus = Cellular_ATRemovePrefix( &pInputLine );
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemoveAllDoubleQuote( pInputLine );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pInputLine );
+        }
+
+        if( atCoreStatus != CELLULAR_AT_SUCCESS )
+        {
+            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+        }
+        else if( isQcsq )
+        {
+            /* The system mode is the first field, read it before the parser tokenizes the line. */
+            if( strncmp( pInputLine, "eMTC", 4 ) == 0 )
+            {
+                pCombinedInfo->rat = CELLULAR_RAT_CATM1;
+            }
+            else if( strncmp( pInputLine, "NBIoT", 5 ) == 0 )
+            {
+                pCombinedInfo->rat = CELLULAR_RAT_NBIOT;
+            }
+            else
+            {
+                pCombinedInfo->rat = CELLULAR_RAT_INVALID;
+            }
+
+            pCombinedInfo->qcsqParsed = _parseQuectelSignalQuality( pInputLine, &pCombinedInfo->signalInfo );
+
+            if( pCombinedInfo->qcsqParsed )
+            {
+                _adaptiveChunkNoteSignal( pContext, &pCombinedInfo->signalInfo );
+            }
+            else
+            {
+                /* Same outcome as a failed AT+QCSQ in Cellular_GetSignalInfo(). */
+                pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+            }
+        }
+        else
+        {
+            pCombinedInfo->csqParsed = _parseSignalQuality( pInputLine, &pCombinedInfo->csqSignalInfo );
+        }
+    }
+
+    return pktStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetSignalInfoSkipRatQuery( CellularHandle_t cellularHandle,
+                                                    CellularSignalInfo_t * pSignalInfo )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    _combinedSignalInfo_t combinedInfo = { 0 };
+    CellularAtReq_t atReqQuerySignalInfo =
+    {
+        "AT+QCSQ",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QCSQ",
+        _Cellular_RecvFuncGetCombinedSignalInfo,
+        &combinedInfo,
+        sizeof( _combinedSignalInfo_t ),
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSignalInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        combinedInfo.signalInfo.rssi = CELLULAR_INVALID_SIGNAL_VALUE;
+        combinedInfo.rat = CELLULAR_RAT_INVALID;
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqQuerySignalInfo,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* The BER and the RSSI fallback only come with AT+CSQ, a failure leaves them out. */
+        atReqQuerySignalInfo.pAtCmd = "AT+CSQ";
+        atReqQuerySignalInfo.pAtRspPrefix = "+CSQ";
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqQuerySignalInfo,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
+
+        if( ( pktStatus == CELLULAR_PKT_STATUS_OK ) && ( combinedInfo.csqParsed ) )
+        {
+            combinedInfo.signalInfo.ber = combinedInfo.csqSignalInfo.ber;
+
+            if( combinedInfo.signalInfo.rssi == CELLULAR_INVALID_SIGNAL_VALUE )
+            {
+                combinedInfo.signalInfo.rssi = combinedInfo.csqSignalInfo.rssi;
+            }
+        }
+        else
+        {
+            LogWarn( ( "Cellular_GetSignalInfoSkipRatQuery: AT+CSQ failed, BER not updated" ) );
+        }
+
+        *pSignalInfo = combinedInfo.signalInfo;
+
+        /* If the convert failed, the API will return CELLULAR_INVALID_SIGNAL_BAR_VALUE in bars field. */
+        ( void ) _Cellular_ComputeSignalBars( combinedInfo.rat, pSignalInfo );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_SocketRecv( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             uint8_t * pBuffer,
+                                             uint32_t bufferLength,
+                                             uint32_t * pReceivedDataLength,
+                                             const TickType_t * pDeadlineTicks )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    uint32_t recvTimeout = DATA_READ_TIMEOUT_MS;
     uint32_t recvLen = bufferLength;
+    bool atPriorityAcquired = false;
     _socketDataRecv_t dataRecv =
     {
         pReceivedDataLength,
@@ -3527,6 +4204,11 @@ CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
             recvTimeout = socketHandle->recvTimeoutMs;
         }
 
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, recvTimeout, &recvTimeout );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
         /* Form the AT command. */
 
         /* The return value of snprintf is not used.
@@ -3536,18 +4218,47 @@ CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
                            ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
                                     "AT+QSSLRECV=" : "AT+QIRD=" ),
                            socketHandle->socketId, recvLen );
-        pktStatus = _Cellular_TimeoutAtcmdDataRecvRequestWithCallback(
-                pContext, atReqSocketRecv, recvTimeout,
-                ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
-                        sslSocketRecvDataPrefix : socketRecvDataPrefix ),
-                NULL );
+        cellularStatus = _Cellular_AtPriorityAcquire( pContext, CELLULAR_AT_PRIORITY_DATA, pDeadlineTicks, &atPriorityAcquired );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        /* The time spent queued for the lane comes out of the deadline. */
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, recvTimeout, &recvTimeout );
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            pktStatus = _Cellular_TimeoutAtcmdDataRecvRequestWithCallback(
+                    pContext, atReqSocketRecv, recvTimeout,
+                    ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
+                            sslSocketRecvDataPrefix : socketRecvDataPrefix ),
+                    NULL );
+        }
+
+        if( atPriorityAcquired )
+        {
+            _Cellular_AtPriorityRelease( pContext );
+        }
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            /* The deadline expired before the read was sent. */
+        }
+        else if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
             /* Reset data handling parameters. */
             LogError( ( "_Cellular_RecvData: Data Receive fail, pktStatus: %d. ", pktStatus ) );
             cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
         }
+        else if( *pReceivedDataLength < recvLen )
+        {
+            /* A short read empties the modem buffer of this socket. */
+            _Cellular_IdleTrackerUpdate( pContext, CELLULAR_IDLE_ACTIVITY_RECV_DRAINED, socketHandle->socketId );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
     }
 
     return cellularStatus;
@@ -3555,6 +4266,40 @@ CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
+                                     CellularSocketHandle_t socketHandle,
+                                     /* coverity[misra_c_2012_rule_8_13_violation] */
+                                     uint8_t * pBuffer,
+                                     uint32_t bufferLength,
+                                     /* coverity[misra_c_2012_rule_8_13_violation] */
+                                     uint32_t * pReceivedDataLength )
+{
+    return _Cellular_SocketRecv( ( CellularContext_t * ) cellularHandle, socketHandle,
+                                 pBuffer, bufferLength, pReceivedDataLength, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_SocketRecvWithDeadline( CellularHandle_t cellularHandle,
+                                                 CellularSocketHandle_t socketHandle,
+                                                 /* coverity[misra_c_2012_rule_8_13_violation] */
+                                                 uint8_t * pBuffer,
+                                                 uint32_t bufferLength,
+                                                 /* coverity[misra_c_2012_rule_8_13_violation] */
+                                                 uint32_t * pReceivedDataLength,
+                                                 TickType_t deadlineTicks )
+{
+    return _Cellular_SocketRecv( ( CellularContext_t * ) cellularHandle, socketHandle,
+                                 pBuffer, bufferLength, pReceivedDataLength, &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
 static bool _parseSocketReceiveStats( char * pRecvStatsPayload,
                                       CellularSocketReceiveStatistics_t * pReceiveStats )
 {
@@ -3753,8 +4498,8 @@ CellularError_t Cellular_GetSocketReceiveStats( CellularHandle_t cellularHandle,
                            ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
                              "AT+QSSLRECV=" : "AT+QIRD=" ),
                            socketHandle->socketId);
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSocketRecvStats,
-                                                               DATA_READ_TIMEOUT_MS );  // FUTURE: Can this be shortened since only querying status
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqSocketRecvStats,
+                                                              DATA_READ_TIMEOUT_MS, NULL );  // FUTURE: Can this be shortened since only querying status
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
@@ -3769,20 +4514,20 @@ CellularError_t Cellular_GetSocketReceiveStats( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-/* coverity[misra_c_2012_rule_8_13_violation] */
-CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
-                                     CellularSocketHandle_t socketHandle,
-                                     const uint8_t * pData,
-                                     uint32_t dataLength,
-                                     /* coverity[misra_c_2012_rule_8_13_violation] */
-                                     uint32_t * pSentDataLength )
+static CellularError_t _Cellular_SocketSend( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             const uint8_t * pData,
+                                             uint32_t dataLength,
+                                             uint32_t * pSentDataLength,
+                                             const TickType_t * pDeadlineTicks )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
+    uint32_t atTimeout = PACKET_REQ_TIMEOUT_MS;
+    uint32_t remainingMs = 0;
+    bool atPriorityAcquired = false;
+    TickType_t sendStartTicks = 0;
     char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
     CellularAtReq_t atReqSocketSend =
     {
@@ -3846,12 +4591,27 @@ CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
             atDataReqSocketSend.dataLen = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
         }
 
+        atDataReqSocketSend.dataLen = _getAdaptiveChunkSize( pContext, atDataReqSocketSend.dataLen );
+
+        /* Before the timeouts are bounded, a throttle delay uses up the deadline. */
+        atDataReqSocketSend.dataLen = _applyThermalGovernor( pContext, atDataReqSocketSend.dataLen, pDeadlineTicks );
+
         /* Check send timeout. If not set by setsockopt, use default value. */
         if( socketHandle->sendTimeoutMs != 0U )
         {
             sendTimeout = socketHandle->sendTimeoutMs;
         }
 
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, atTimeout, &atTimeout );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, sendTimeout, &sendTimeout );
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
         /* Form the AT command. */
 
         /* The return value of snprintf is not used.
@@ -3862,87 +4622,55 @@ CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
                                     "AT+QSSLSEND=" : "AT+QISEND=" ),
                            socketHandle->socketId, atDataReqSocketSend.dataLen );
 
-        pktStatus = _Cellular_AtcmdDataSend( pContext, atReqSocketSend, atDataReqSocketSend,
-                                             socketSendDataPrefix, NULL,
-                                             PACKET_REQ_TIMEOUT_MS, sendTimeout, 0U );
+        cellularStatus = _Cellular_AtPriorityAcquire( pContext, CELLULAR_AT_PRIORITY_DATA, pDeadlineTicks, &atPriorityAcquired );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        /* The time spent queued for the lane comes out of the deadline. */
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            LogError( ( "Cellular_SocketSend: Data send fail, PktRet: %d", pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, UINT32_MAX, &remainingMs );
         }
-    }
-
-    return cellularStatus;
-}
 
-/*-----------------------------------------------------------*/
+        /* The command and data phases run one after the other, so they split what is left
+         * instead of each being bounded to all of it. */
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pDeadlineTicks != NULL ) )
+        {
+            if( atTimeout > ( ( remainingMs + 1U ) / 2U ) )
+            {
+                atTimeout = ( remainingMs + 1U ) / 2U;
+            }
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
-                                      CellularSocketHandle_t socketHandle,
-                                      bool removeSocketOnError )
-{
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSockClose =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+            if( sendTimeout > ( remainingMs - atTimeout ) )
+            {
+                sendTimeout = remainingMs - atTimeout;
+            }
 
-    /* Make sure the library is open. */
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+            if( sendTimeout == 0U )
+            {
+                LogWarn( ( "Cellular_SocketSend: deadline too close to send data" ) );
+                cellularStatus = CELLULAR_TIMEOUT;
+            }
+        }
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
-    }
-    else if( socketHandle == NULL )
-    {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
-    }
-    else
-    {
-        if( socketHandle->socketState == SOCKETSTATE_CONNECTING )
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            LogWarn( ( "Cellular_SocketClose: Socket state is SOCKETSTATE_CONNECTING." ) );
+            sendStartTicks = _Cellular_GetTicks();
+            pktStatus = _Cellular_AtcmdDataSend( pContext, atReqSocketSend, atDataReqSocketSend,
+                                                 socketSendDataPrefix, NULL,
+                                                 atTimeout, sendTimeout, 0U );
+            _adaptiveChunkFeedback( pContext, atDataReqSocketSend.dataLen, *pSentDataLength,
+                                    ( pktStatus == CELLULAR_PKT_STATUS_OK ),
+                                    ( uint32_t ) ( ( _Cellular_GetTicks() - sendStartTicks ) * portTICK_PERIOD_MS ) );
         }
 
-        if( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
-            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
-            ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) )
+        if( atPriorityAcquired )
         {
-            /* Form the AT command. */
-
-            /* The return value of snprintf is not used.
-             * The max length of the string is fixed and checked offline. */
-            /* coverity[misra_c_2012_rule_21_6_violation]. */
-            ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%lu",
-                               ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
-                                        "AT+QSSLCLOSE=" : "AT+QICLOSE=" ),
-                               socketHandle->socketId );
-            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSockClose,
-                                                                   SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS );
-
-            if( pktStatus != CELLULAR_PKT_STATUS_OK )
-            {
-                LogError( ( "*** Cellular_SocketClose: Socket close failed, cmdBuf:%s, PktRet: %d <---------", cmdBuf, pktStatus ) );
-                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-            }
+            _Cellular_AtPriorityRelease( pContext );
         }
 
-        if( (cellularStatus == CELLULAR_SUCCESS ) || ( removeSocketOnError ) )
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
-            /* Ignore the result from the info, and force to remove the socket. */
-            cellularStatus = _Cellular_RemoveSocketData(pContext, socketHandle);
+            LogError( ( "Cellular_SocketSend: Data send fail, PktRet: %d", pktStatus ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
         }
     }
 
@@ -3953,16 +4681,1233 @@ CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
-                                        CellularSocketHandle_t socketHandle,
-                                        CellularSocketAccessMode_t dataAccessMode,
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
+                                     CellularSocketHandle_t socketHandle,
+                                     const uint8_t * pData,
+                                     uint32_t dataLength,
+                                     /* coverity[misra_c_2012_rule_8_13_violation] */
+                                     uint32_t * pSentDataLength )
+{
+    return _Cellular_SocketSend( ( CellularContext_t * ) cellularHandle, socketHandle,
+                                 pData, dataLength, pSentDataLength, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_SocketSendWithDeadline( CellularHandle_t cellularHandle,
+                                                 CellularSocketHandle_t socketHandle,
+                                                 const uint8_t * pData,
+                                                 uint32_t dataLength,
+                                                 /* coverity[misra_c_2012_rule_8_13_violation] */
+                                                 uint32_t * pSentDataLength,
+                                                 TickType_t deadlineTicks )
+{
+    return _Cellular_SocketSend( ( CellularContext_t * ) cellularHandle, socketHandle,
+                                 pData, dataLength, pSentDataLength, &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Without known PSM timers the modem is taken as always reachable and there is no window to wait for. */
+static bool _isPsmActiveWindowOpen( cellularModuleContext_t * pModuleContext,
+                                    bool * pPsmNegotiated,
+                                    uint32_t * pWakeCostMs )
+{
+    bool windowOpen = false;
+    const TickType_t nowTicks = _Cellular_GetTicks();
+
+    PlatformMutex_Lock( &pModuleContext->psmMutex );
+    *pPsmNegotiated = ( pModuleContext->psmTimeline.timersKnown ) &&
+                      ( pModuleContext->psmTimeline.periodicTauSeconds != 0U );
+    *pWakeCostMs = ( pModuleContext->psmTimeline.activeTimeSeconds * 1000U ) + CELLULAR_BG770_DEFERRED_SEND_WAKE_OVERHEAD_MS;
+
+    if( *pPsmNegotiated )
+    {
+        windowOpen = ( pModuleContext->psmTimeline.inPsm == false ) &&
+                     ( ( int32_t ) ( nowTicks - pModuleContext->psmTimeline.nextPsmEntryTicks ) < 0 );
+    }
+
+    PlatformMutex_Unlock( &pModuleContext->psmMutex );
+
+    return windowOpen;
+}
+
+/*-----------------------------------------------------------*/
+
+/* A send may take only part of a payload, the rest follows until it is all out. A send that takes
+ * nothing ends the payload, the modem has no room for it. */
+static CellularError_t _sendDeferredPayload( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             const uint8_t * pData,
+                                             uint32_t dataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t sentDataLength = 0;
+    uint32_t totalSentLength = 0;
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( totalSentLength < dataLength ) )
+    {
+        sentDataLength = 0;
+        cellularStatus = _Cellular_SocketSend( pContext, socketHandle, &pData[ totalSentLength ],
+                                               dataLength - totalSentLength, &sentDataLength, NULL );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogWarn( ( "_sendDeferredPayload: Send failed after %lu of %lu bytes, status %d",
+                       totalSentLength, dataLength, cellularStatus ) );
+        }
+        else if( ( sentDataLength == 0U ) || ( sentDataLength > ( dataLength - totalSentLength ) ) )
+        {
+            LogWarn( ( "_sendDeferredPayload: Modem took %lu bytes after %lu of %lu bytes",
+                       sentDataLength, totalSentLength, dataLength ) );
+            cellularStatus = CELLULAR_TIMEOUT;
+        }
+        else
+        {
+            totalSentLength += sentDataLength;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Payloads are taken off the queue one at a time so the mutex is never held across a send.
+ * A flush outside an active window wakes the modem itself, so one of its payloads did not avoid a wake. */
+static CellularError_t _flushDeferredSends( CellularContext_t * pContext,
+                                            cellularModuleContext_t * pModuleContext,
+                                            bool inActiveWindow )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularError_t sendStatus = CELLULAR_SUCCESS;
+    cellularDeferredSend_t deferredSend;
+    bool entryTaken = true;
+    bool psmNegotiated = false;
+    uint32_t wakeCostMs = 0;
+    uint32_t sentCount = 0;
+    uint32_t failedCount = 0;
+    uint32_t wakeupsAvoided = 0;
+
+    while( entryTaken )
+    {
+        PlatformMutex_Lock( &pModuleContext->deferredSendMutex );
+        entryTaken = ( pModuleContext->deferredSendCount > 0U );
+
+        if( entryTaken )
+        {
+            deferredSend = pModuleContext->deferredSends[ pModuleContext->deferredSendHead ];
+            pModuleContext->deferredSendHead = ( uint8_t ) ( ( pModuleContext->deferredSendHead + 1U ) %
+                                                             CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH );
+            pModuleContext->deferredSendCount--;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->deferredSendMutex );
+
+        if( entryTaken )
+        {
+            sendStatus = _sendDeferredPayload( pContext, deferredSend.socketHandle, deferredSend.data,
+                                               deferredSend.dataLength );
+
+            if( sendStatus == CELLULAR_SUCCESS )
+            {
+                sentCount++;
+
+                if( deferredSend.outsideActiveWindow )
+                {
+                    wakeupsAvoided++;
+                }
+            }
+            else
+            {
+                LogWarn( ( "_flushDeferredSends: Deferred send of %lu bytes failed, status %d",
+                           deferredSend.dataLength, sendStatus ) );
+                failedCount++;
+
+                if( cellularStatus == CELLULAR_SUCCESS )
+                {
+                    cellularStatus = sendStatus;
+                }
+            }
+        }
+    }
+
+    if( ( sentCount + failedCount ) > 0U )
+    {
+        if( ( inActiveWindow == false ) && ( wakeupsAvoided > 0U ) )
+        {
+            wakeupsAvoided--;
+        }
+
+        ( void ) _isPsmActiveWindowOpen( pModuleContext, &psmNegotiated, &wakeCostMs );
+
+        PlatformMutex_Lock( &pModuleContext->deferredSendMutex );
+        pModuleContext->deferredSendStats.flushCount++;
+        pModuleContext->deferredSendStats.forcedFlushCount += ( inActiveWindow ) ? 0U : 1U;
+        pModuleContext->deferredSendStats.sentCount += sentCount;
+        pModuleContext->deferredSendStats.failedCount += failedCount;
+        pModuleContext->deferredSendStats.wakeupsAvoided += wakeupsAvoided;
+        pModuleContext->deferredSendStats.airtimeSavedMs += ( uint64_t ) wakeupsAvoided * wakeCostMs;
+        PlatformMutex_Unlock( &pModuleContext->deferredSendMutex );
+
+        LogDebug( ( "_flushDeferredSends: Sent %lu, failed %lu, avoided %lu wake ups",
+                    sentCount, failedCount, wakeupsAvoided ) );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _purgeDeferredSends( cellularModuleContext_t * pModuleContext,
+                                 CellularSocketHandle_t socketHandle )
+{
+    uint8_t readIndex = 0;
+    uint8_t keptCount = 0;
+    uint8_t slot = 0;
+    uint8_t keptSlot = 0;
+
+    PlatformMutex_Lock( &pModuleContext->deferredSendMutex );
+
+    /* Compact the queue in place, keeping the order of the remaining payloads. */
+    for( readIndex = 0; readIndex < pModuleContext->deferredSendCount; readIndex++ )
+    {
+        slot = ( uint8_t ) ( ( pModuleContext->deferredSendHead + readIndex ) % CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH );
+
+        if( pModuleContext->deferredSends[ slot ].socketHandle != socketHandle )
+        {
+            keptSlot = ( uint8_t ) ( ( pModuleContext->deferredSendHead + keptCount ) % CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH );
+
+            if( keptSlot != slot )
+            {
+                pModuleContext->deferredSends[ keptSlot ] = pModuleContext->deferredSends[ slot ];
+            }
+
+            keptCount++;
+        }
+    }
+
+    pModuleContext->deferredSendStats.failedCount += ( uint32_t ) pModuleContext->deferredSendCount - keptCount;
+    pModuleContext->deferredSendCount = keptCount;
+    PlatformMutex_Unlock( &pModuleContext->deferredSendMutex );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketSendDeferred( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             const uint8_t * pData,
+                                             uint32_t dataLength,
+                                             bool urgent )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularError_t flushStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularDeferredSend_t * pDeferredSend = NULL;
+    bool psmNegotiated = false;
+    bool windowOpen = false;
+    bool queueFull = false;
+    uint32_t wakeCostMs = 0;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogError( ( "_Cellular_CheckLibraryStatus failed." ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pData == NULL ) || ( dataLength == 0U ) || ( dataLength > CELLULAR_BG770_DEFERRED_SEND_MAX_DATA_SIZE ) )
+    {
+        LogError( ( "Cellular_SocketSendDeferred: Invalid parameter, data length %lu.", dataLength ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+    {
+        cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        windowOpen = _isPsmActiveWindowOpen( pModuleContext, &psmNegotiated, &wakeCostMs );
+
+        if( ( urgent ) || ( psmNegotiated == false ) )
+        {
+            cellularStatus = _sendDeferredPayload( pContext, socketHandle, pData, dataLength );
+
+            /* The modem is awake now, the queue rides along. */
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( psmNegotiated ) )
+            {
+                flushStatus = _flushDeferredSends( pContext, pModuleContext, true );
+                ( void ) Cellular_SetPSMEntry( cellularHandle, CELLULAR_PSM_ENTER_MODE_IMMEDIATE );
+            }
+        }
+        else
+        {
+            PlatformMutex_Lock( &pModuleContext->deferredSendMutex );
+            queueFull = ( pModuleContext->deferredSendCount >= CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH );
+            PlatformMutex_Unlock( &pModuleContext->deferredSendMutex );
+
+            if( queueFull )
+            {
+                LogDebug( ( "Cellular_SocketSendDeferred: Queue full, flushing" ) );
+                flushStatus = _flushDeferredSends( pContext, pModuleContext, windowOpen );
+                ( void ) Cellular_SetPSMEntry( cellularHandle, CELLULAR_PSM_ENTER_MODE_IMMEDIATE );
+            }
+
+            PlatformMutex_Lock( &pModuleContext->deferredSendMutex );
+
+            if( pModuleContext->deferredSendCount < CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH )
+            {
+                pDeferredSend = &pModuleContext->deferredSends[ ( pModuleContext->deferredSendHead + pModuleContext->deferredSendCount ) %
+                                                                CELLULAR_BG770_DEFERRED_SEND_QUEUE_LENGTH ];
+                pDeferredSend->socketHandle = socketHandle;
+                pDeferredSend->outsideActiveWindow = ( windowOpen == false );
+                pDeferredSend->dataLength = dataLength;
+                ( void ) memcpy( pDeferredSend->data, pData, dataLength );
+                pModuleContext->deferredSendCount++;
+                pModuleContext->deferredSendStats.queuedCount++;
+            }
+            else
+            {
+                /* Another task filled the queue during the flush. */
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->deferredSendMutex );
+        }
+
+        if( flushStatus != CELLULAR_SUCCESS )
+        {
+            LogWarn( ( "Cellular_SocketSendDeferred: Flushing the queue failed, status %d", flushStatus ) );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_FlushDeferredSends( CellularHandle_t cellularHandle,
+                                             bool force )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool psmNegotiated = false;
+    bool windowOpen = false;
+    bool queueEmpty = true;
+    uint32_t wakeCostMs = 0;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        windowOpen = _isPsmActiveWindowOpen( pModuleContext, &psmNegotiated, &wakeCostMs );
+
+        PlatformMutex_Lock( &pModuleContext->deferredSendMutex );
+        queueEmpty = ( pModuleContext->deferredSendCount == 0U );
+        PlatformMutex_Unlock( &pModuleContext->deferredSendMutex );
+
+        /* PSM may have been turned off since the payloads were queued, then they go out now. */
+        if( ( queueEmpty == false ) && ( ( windowOpen ) || ( force ) || ( psmNegotiated == false ) ) )
+        {
+            cellularStatus = _flushDeferredSends( pContext, pModuleContext, ( windowOpen ) || ( psmNegotiated == false ) );
+
+            if( psmNegotiated )
+            {
+                ( void ) Cellular_SetPSMEntry( cellularHandle, CELLULAR_PSM_ENTER_MODE_IMMEDIATE );
+            }
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_SocketClose( CellularContext_t * pContext,
+                                              CellularSocketHandle_t socketHandle,
+                                              bool removeSocketOnError,
+                                              const TickType_t * pDeadlineTicks )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t timeoutMs = SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    CellularAtReq_t atReqSockClose =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* Make sure the library is open. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else
+    {
+        if( socketHandle->socketState == SOCKETSTATE_CONNECTING )
+        {
+            LogWarn( ( "Cellular_SocketClose: Socket state is SOCKETSTATE_CONNECTING." ) );
+        }
+
+        if( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
+            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
+            ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) )
+        {
+            cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &timeoutMs );
+        }
+
+        if( ( cellularStatus == CELLULAR_SUCCESS ) &&
+            ( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
+              ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
+              ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) ) )
+        {
+            /* Form the AT command. */
+
+            /* The return value of snprintf is not used.
+             * The max length of the string is fixed and checked offline. */
+            /* coverity[misra_c_2012_rule_21_6_violation]. */
+            ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%lu",
+                               ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
+                                        "AT+QSSLCLOSE=" : "AT+QICLOSE=" ),
+                               socketHandle->socketId );
+            pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_CONTROL, atReqSockClose, timeoutMs, pDeadlineTicks );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "*** Cellular_SocketClose: Socket close failed, cmdBuf:%s, PktRet: %d <---------", cmdBuf, pktStatus ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            }
+        }
+
+        if( (cellularStatus == CELLULAR_SUCCESS ) || ( removeSocketOnError ) )
+        {
+            /* The handle is freed with the socket data, drop what is still queued for it. */
+            if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+            {
+                _purgeDeferredSends( pModuleContext, socketHandle );
+
+                /* URC events still queued for this index belong to the closed socket, not to its next user. */
+                if( socketHandle->socketId < CELLULAR_NUM_SOCKET_MAX )
+                {
+                    PlatformMutex_Lock( &pModuleContext->urcDispatchMutex );
+                    pModuleContext->socketGeneration[ socketHandle->socketId ]++;
+                    PlatformMutex_Unlock( &pModuleContext->urcDispatchMutex );
+                }
+            }
+
+            _Cellular_IdleTrackerUpdate( pContext, CELLULAR_IDLE_ACTIVITY_RECV_DRAINED, socketHandle->socketId );
+
+            /* Ignore the result from the info, and force to remove the socket. */
+            cellularStatus = _Cellular_RemoveSocketData(pContext, socketHandle);
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      bool removeSocketOnError )
+{
+    return _Cellular_SocketClose( ( CellularContext_t * ) cellularHandle, socketHandle, removeSocketOnError, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketCloseWithDeadline( CellularHandle_t cellularHandle,
+                                                  CellularSocketHandle_t socketHandle,
+                                                  bool removeSocketOnError,
+                                                  TickType_t deadlineTicks )
+{
+    return _Cellular_SocketClose( ( CellularContext_t * ) cellularHandle, socketHandle, removeSocketOnError,
+                                  &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_SocketConnect( CellularContext_t * pContext,
+                                                CellularSocketHandle_t socketHandle,
+                                                CellularSocketAccessMode_t dataAccessMode,
+                                                const CellularSocketAddress_t * pRemoteSocketAddress,
+                                                const TickType_t * pDeadlineTicks )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t timeoutMs = 0;
+    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+    CellularAtReq_t atReqSocketConnect =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* Make sure the library is open. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogError( ( "Cellular_SocketConnect: _Cellular_CheckLibraryStatus failed." ) );
+    }
+    else if( pRemoteSocketAddress == NULL )
+    {
+        LogError( ( "Cellular_SocketConnect: Invalid socket address." ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketHandle == NULL )
+    {
+        LogError( ( "Cellular_SocketConnect: Invalid socket handle." ) );
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
+    {
+        LogError( ( "Cellular_SocketConnect: Not allowed in state %d.", socketHandle->socketState ) );
+        cellularStatus = CELLULAR_NOT_ALLOWED;
+    }
+    else
+    {
+        cellularStatus = storeAccessModeAndAddress( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Builds the Socket connect command. */
+        cellularStatus = buildSocketConnect( socketHandle, cmdBuf, sizeof(cmdBuf) );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        timeoutMs = ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
+                        SSL_SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS : SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS );
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &timeoutMs );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Set the socket state to connecting state. If cellular modem returns error,
+         * revert the state to allocated state. */
+        socketHandle->socketState = SOCKETSTATE_CONNECTING;
+
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_DATA, atReqSocketConnect, timeoutMs, pDeadlineTicks );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_SocketConnect: Socket connect failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+            /* Revert the state to allocated state. */
+            socketHandle->socketState = SOCKETSTATE_ALLOCATED;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
+                                        CellularSocketHandle_t socketHandle,
+                                        CellularSocketAccessMode_t dataAccessMode,
                                         const CellularSocketAddress_t * pRemoteSocketAddress )
 {
+    return _Cellular_SocketConnect( ( CellularContext_t * ) cellularHandle, socketHandle, dataAccessMode,
+                                    pRemoteSocketAddress, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketConnectWithDeadline( CellularHandle_t cellularHandle,
+                                                    CellularSocketHandle_t socketHandle,
+                                                    CellularSocketAccessMode_t dataAccessMode,
+                                                    const CellularSocketAddress_t * pRemoteSocketAddress,
+                                                    TickType_t deadlineTicks )
+{
+    return _Cellular_SocketConnect( ( CellularContext_t * ) cellularHandle, socketHandle, dataAccessMode,
+                                    pRemoteSocketAddress, &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
+                                       CellularPdnStatus_t * pPdnStatusBuffers,
+                                       uint8_t numStatusBuffers,
+                                       uint8_t * pNumStatus )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    const CellularPdnStatus_t * pTempPdnStatusBuffer = pPdnStatusBuffers;
+    uint8_t numBuffers = 0;
+    CellularAtReq_t atReqGetPdnStatus =
+    {
+        "AT+QIACT?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QIACT",
+        _Cellular_RecvFuncGetPdnStatus,
+        pPdnStatusBuffers,
+        numStatusBuffers,
+    };
+
+    if( ( pTempPdnStatusBuffer == NULL ) || ( pNumStatus == NULL ) || ( numStatusBuffers < 1u ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+        LogWarn( ( "_Cellular_GetPdnStatus: Bad input Parameter " ) );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPdnStatus );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Populate the Valid number of statuses. */
+        *pNumStatus = 0;
+        numBuffers = numStatusBuffers;
+
+        while( numBuffers != 0U )
+        {
+            /* Check if the PDN state is valid. The context ID of the first
+             * invalid PDN status is set to FF. */
+            if( ( pTempPdnStatusBuffer->contextId != INVALID_PDN_INDEX ) &&
+                ( pTempPdnStatusBuffer->contextId >= CELLULAR_PDN_CONTEXT_ID_MIN ) &&
+                ( pTempPdnStatusBuffer->contextId <= CELLULAR_PDN_CONTEXT_ID_MAX ) )
+            {
+                ( *pNumStatus ) += 1U;
+            }
+            else
+            {
+                break;
+            }
+
+            numBuffers--;
+            pTempPdnStatusBuffer++;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
+                                           CellularSimCardStatus_t * pSimCardStatus )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    _simStat_t simStat = { CELLULAR_SIM_CARD_UNKNOWN, false };
+    CellularAtReq_t atReqGetSimCardStatus =
+    {
+        "AT+QSIMSTAT?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QSIMSTAT",
+        _Cellular_RecvFuncGetSimCardStatus,
+        &simStat,
+        sizeof( _simStat_t ),
+    };
+    CellularAtReq_t atReqGetSimLockStatus =
+    {
+        "AT+CPIN?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CPIN",
+        _Cellular_RecvFuncGetSimLockStatus,
+        &pSimCardStatus->simCardLockState,
+        sizeof( CellularSimCardLockState_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSimCardStatus == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        /* Initialize the sim state and the sim lock state. */
+        pSimCardStatus->simCardState = CELLULAR_SIM_CARD_UNKNOWN;
+        pSimCardStatus->simCardLockState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
+
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimCardStatus );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pSimCardStatus->simCardState = simStat.simCardState;
+            _Cellular_SimStateUpdate( pContext, simStat.simCardState, simStat.urcEnabled );
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimLockStatus );
+        }
+
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        LogDebug( ( "_Cellular_GetSimStatus, Sim Insert State[%d], Lock State[%d]",
+                    pSimCardStatus->simCardState, pSimCardStatus->simCardLockState ) );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetTrackedSimCardState( CellularHandle_t cellularHandle,
+                                                 CellularSimCardState_t * pSimCardState )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool tracked = false;
+    _simStat_t simStat = { CELLULAR_SIM_CARD_UNKNOWN, false };
+    CellularAtReq_t atReqGetSimCardStatus =
+    {
+        "AT+QSIMSTAT?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QSIMSTAT",
+        _Cellular_RecvFuncGetSimCardStatus,
+        &simStat,
+        sizeof( _simStat_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSimCardState == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+
+        /* Without the URC a change would go unnoticed, the tracked state is only trusted while it is enabled. */
+        if( ( pModuleContext->simStateKnown ) && ( pModuleContext->simStateUrcEnabled ) )
+        {
+            *pSimCardState = pModuleContext->simCardState;
+            tracked = true;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( tracked == false ) )
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimCardStatus );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            *pSimCardState = simStat.simCardState;
+            _Cellular_SimStateUpdate( pContext, simStat.simCardState, simStat.urcEnabled );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetSimStateUrcEnabled( CellularHandle_t cellularHandle,
+                                                bool enable )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularSimCardState_t simCardState = CELLULAR_SIM_CARD_UNKNOWN;
+    CellularAtReq_t atReqSetSimStatUrc =
+    {
+        ( enable ) ? "AT+QSIMSTAT=1" : "AT+QSIMSTAT=0",
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetSimStatUrc );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( enable ) )
+    {
+        /* The URC only reports changes, read the current state once so the tracked state starts out known. */
+        cellularStatus = Cellular_GetTrackedSimCardState( cellularHandle, &simCardState );
+    }
+    else if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        _Cellular_SimStateUpdate( pContext, CELLULAR_SIM_CARD_UNKNOWN, false );
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_RegisterUrcSimStateChangedCallback( CellularHandle_t cellularHandle,
+                                                             CellularUrcSimStateChangedCallback_t simStateChangedCallback,
+                                                             void * pCallbackContext )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+        pModuleContext->simStateChangedCallback = simStateChangedCallback;
+        pModuleContext->pSimStateChangedCallbackContext = pCallbackContext;
+        PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_GetSimCardInfo( CellularContext_t * pContext,
+                                                 CellularSimCardInfo_t * pSimCardInfo,
+                                                 bool forceRefresh )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool cacheHit = false;
+    uint32_t identityGeneration = 0;
+
+    CellularAtReq_t atReqGetIccid =
+    {
+        "AT+QCCID",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QCCID",
+        _Cellular_RecvFuncGetIccid,
+        pSimCardInfo->iccid,
+        CELLULAR_ICCID_MAX_SIZE + 1U,
+    };
+    CellularAtReq_t atReqGetImsi =
+    {
+        "AT+CIMI",
+        CELLULAR_AT_WO_PREFIX,
+        NULL,
+        _Cellular_RecvFuncGetImsi,
+        pSimCardInfo->imsi,
+        CELLULAR_IMSI_MAX_SIZE + 1U,
+    };
+    CellularAtReq_t atReqGetHplmn =
+    {
+        "AT+CRSM=176,28514,0,0,0",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CRSM",
+        _Cellular_RecvFuncGetHplmn,
+        &pSimCardInfo->plmn,
+        sizeof( CellularPlmnInfo_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSimCardInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+
+        /* Without the QSIMSTAT URC a swapped SIM would not invalidate the cache, it is only trusted while enabled. */
+        if( ( forceRefresh == false ) && ( pModuleContext->simCardInfoValid ) && ( pModuleContext->simStateUrcEnabled ) )
+        {
+            *pSimCardInfo = pModuleContext->simCardInfo;
+            cacheHit = true;
+        }
+
+        identityGeneration = pModuleContext->identityGeneration;
+        PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
+    {
+        ( void ) memset( pSimCardInfo, 0, sizeof( CellularSimCardInfo_t ) );
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetImsi );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetHplmn );
+        }
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetIccid );
+        }
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+        else
+        {
+            LogDebug( ( "SimInfo updated: IMSI:%s, Hplmn:%s%s, ICCID:%s",
+                        pSimCardInfo->imsi, pSimCardInfo->plmn.mcc, pSimCardInfo->plmn.mnc,
+                        pSimCardInfo->iccid ) );
+
+            /* A SIM or modem event during the reads may have made them stale, they are not cached then. */
+            PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+
+            if( identityGeneration == pModuleContext->identityGeneration )
+            {
+                pModuleContext->simCardInfo = *pSimCardInfo;
+                pModuleContext->simCardInfoValid = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
+                                         CellularSimCardInfo_t * pSimCardInfo )
+{
+    return _Cellular_GetSimCardInfo( ( CellularContext_t * ) cellularHandle, pSimCardInfo, false );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetSimCardInfoWithRefresh( CellularHandle_t cellularHandle,
+                                                    CellularSimCardInfo_t * pSimCardInfo,
+                                                    bool forceRefresh )
+{
+    return _Cellular_GetSimCardInfo( ( CellularContext_t * ) cellularHandle, pSimCardInfo, forceRefresh );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_GetModemInfo( CellularContext_t * pContext,
+                                               CellularModemInfo_t * pModemInfo,
+                                               bool forceRefresh )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool cacheHit = false;
+    uint32_t identityGeneration = 0;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pModemInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+
+        if( ( forceRefresh == false ) && ( pModuleContext->modemInfoValid ) )
+        {
+            *pModemInfo = pModuleContext->modemInfo;
+            cacheHit = true;
+        }
+
+        identityGeneration = pModuleContext->identityGeneration;
+        PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
+    {
+        cellularStatus = Cellular_CommonGetModemInfo( ( CellularHandle_t ) pContext, pModemInfo );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+
+            if( identityGeneration == pModuleContext->identityGeneration )
+            {
+                pModuleContext->modemInfo = *pModemInfo;
+                pModuleContext->modemInfoValid = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetModemInfo( CellularHandle_t cellularHandle,
+                                       CellularModemInfo_t * pModemInfo )
+{
+    return _Cellular_GetModemInfo( ( CellularContext_t * ) cellularHandle, pModemInfo, false );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetModemInfoWithRefresh( CellularHandle_t cellularHandle,
+                                                  CellularModemInfo_t * pModemInfo,
+                                                  bool forceRefresh )
+{
+    return _Cellular_GetModemInfo( ( CellularContext_t * ) cellularHandle, pModemInfo, forceRefresh );
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandle_t cellularHandle,
+                                                                   CellularUrcSignalStrengthChangedCallback_t signalStrengthChangedCallback,
+                                                                   void * pCallbackContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool historyEnabled = false;
+
+    /* pContext is checked in the common library. */
+    cellularStatus = Cellular_CommonRegisterUrcSignalStrengthChangedCallback(
+        cellularHandle, signalStrengthChangedCallback, pCallbackContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->signalHistoryMutex );
+        pModuleContext->signalCallbackRegistered = ( signalStrengthChangedCallback != NULL );
+        historyEnabled = pModuleContext->signalHistoryEnabled;
+        PlatformMutex_Unlock( &pModuleContext->signalHistoryMutex );
+
+        /* The signal history keeps the URC on without a callback. */
+        if( ( signalStrengthChangedCallback != NULL ) || ( historyEnabled ) )
+        {
+            cellularStatus = controlSignalStrengthIndication( pContext, true );
+        }
+        else
+        {
+            cellularStatus = controlSignalStrengthIndication( pContext, false );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_RegisterPsmTimelineCallback( CellularHandle_t cellularHandle,
+                                                      CellularPsmTimelineCallback_t psmTimelineCallback,
+                                                      void * pCallbackContext )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->psmMutex );
+        pModuleContext->psmTimelineCallback = psmTimelineCallback;
+        pModuleContext->pPsmTimelineCallbackContext = pCallbackContext;
+        PlatformMutex_Unlock( &pModuleContext->psmMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetSignalHistoryEnabled( CellularHandle_t cellularHandle,
+                                                  bool enable )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool callbackRegistered = false;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->signalHistoryMutex );
+        pModuleContext->signalHistoryEnabled = enable;
+        callbackRegistered = pModuleContext->signalCallbackRegistered;
+        PlatformMutex_Unlock( &pModuleContext->signalHistoryMutex );
+
+        /* A registered callback keeps the URC on without the history. */
+        if( ( enable ) || ( callbackRegistered == false ) )
+        {
+            cellularStatus = controlSignalStrengthIndication( pContext, enable );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Exactly one of pResolvedAddress and pResolvedAddresses is used. A multiple result query waits for every
+ * address line of the URC and bypasses the cache lookup, the cache only holds the first address. */
+static CellularError_t _Cellular_GetHostByName( CellularContext_t * pContext,
+                                                uint8_t contextId,
+                                                const char * pcHostName,
+                                                char * pResolvedAddress,
+                                                CellularIPAddress_t * pResolvedAddresses,
+                                                uint8_t maxAddressCount,
+                                                uint8_t * pAddressCount,
+                                                CellularAtPriorityClass_t priorityClass,
+                                                bool useCache,
+                                                const TickType_t * pDeadlineTicks )
+{
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSocketConnect =
+    uint32_t atTimeoutMs = PACKET_REQ_TIMEOUT_MS;
+    uint32_t queryTimeoutMs = DNS_QUERY_TIMEOUT_MS;
+    char cmdBuf[ CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE ];
+    cellularDnsQueryCompletion_t dnsQueryCompletion = { 0 };
+    cellularDnsQuery_t * pQuery = NULL;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularDnsCacheLookupResult_t cacheLookupResult = CELLULAR_DNS_CACHE_MISS;
+    int32_t failureResultCode = 0;
+    bool cacheHit = false;
+    CellularAtReq_t atReqQueryDns =
     {
         cmdBuf,
         CELLULAR_AT_NO_RESULT,
@@ -3972,129 +5917,175 @@ CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
         0,
     };
 
-    /* Make sure the library is open. */
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
-        LogError( ( "Cellular_SocketConnect: _Cellular_CheckLibraryStatus failed." ) );
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pRemoteSocketAddress == NULL )
+    else if( ( pcHostName == NULL ) || ( ( pResolvedAddress == NULL ) && ( pResolvedAddresses == NULL ) ) )
     {
-        LogError( ( "Cellular_SocketConnect: Invalid socket address." ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-    else if( socketHandle == NULL )
-    {
-        LogError( ( "Cellular_SocketConnect: Invalid socket handle." ) );
-        cellularStatus = CELLULAR_INVALID_HANDLE;
-    }
-    else if( ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
+    else if( ( pResolvedAddresses != NULL ) && ( ( maxAddressCount == 0U ) || ( pAddressCount == NULL ) ) )
     {
-        LogError( ( "Cellular_SocketConnect: Not allowed in state %d.", socketHandle->socketState ) );
-        cellularStatus = CELLULAR_NOT_ALLOWED;
+        cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        cellularStatus = storeAccessModeAndAddress( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+        cellularStatus = _Cellular_IsValidPdn( contextId );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Builds the Socket connect command. */
-        cellularStatus = buildSocketConnect( socketHandle, cmdBuf, sizeof(cmdBuf) );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pResolvedAddresses != NULL ) )
+    {
+        *pAddressCount = 0;
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( useCache ) )
+    {
+        /* A multiple result query passes no address, only a held down failure is reported for it. */
+        cacheLookupResult = _Cellular_DnsCacheLookup( pModuleContext, contextId, pcHostName, pResolvedAddress,
+                                                      &failureResultCode );
+
+        if( cacheLookupResult == CELLULAR_DNS_CACHE_HIT )
+        {
+            LogDebug( ( "Cellular_GetHostByName: %s resolved from the DNS cache", pcHostName ) );
+            cacheHit = true;
+        }
+        else if( cacheLookupResult == CELLULAR_DNS_CACHE_NEGATIVE_HIT )
+        {
+            LogWarn( ( "Cellular_GetHostByName: %s failed recently, result code: %ld, not queried again",
+                       pcHostName, failureResultCode ) );
+            cellularStatus = CELLULAR_UNKNOWN;
+        }
+        else
+        {
+            /* Not cached, query the modem. */
+        }
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
+    {
+        cellularStatus = _claimDnsQuery( pModuleContext, pDeadlineTicks, &pQuery );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* The deadline is checked again, waiting for a free slot may have consumed the budget. */
+            cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, atTimeoutMs, &atTimeoutMs );
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+                _releaseDnsQuery( pModuleContext, pQuery );
+            }
+        }
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+    /* Send the AT command, the query is pending before the command so that a fast URC finds it. */
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
     {
-        /* Set the socket state to connecting state. If cellular modem returns error,
-         * revert the state to allocated state. */
-        socketHandle->socketState = SOCKETSTATE_CONNECTING;
+        PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
+        pQuery->pResolvedAddress = pResolvedAddress;
+        pQuery->pResolvedAddresses = pResolvedAddresses;
+        pQuery->resolvedAddressesMax = maxAddressCount;
+        pModuleContext->dnsQuerySequence++;
+        pQuery->sequence = pModuleContext->dnsQuerySequence;
+        pQuery->sentTicks = _Cellular_GetTicks();
+        pQuery->contextId = contextId;
+        pQuery->pending = true;
+        ( void ) registerDnsEventCallback( pModuleContext, _dnsResultCallback, NULL );
+        PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
 
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback(
-                pContext, atReqSocketConnect,
-                ( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_SSL_OVER_TCP ?
-                        SSL_SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS : SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS ) );
+        /* The return value of snprintf is not used.
+         * The max length of the string is fixed and checked offline. */
+        /* coverity[misra_c_2012_rule_21_6_violation]. */
+        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE,
+                           "AT+QIDNSGIP=%u,\"%s\"", contextId, pcHostName );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, priorityClass, atReqQueryDns, atTimeoutMs, pDeadlineTicks );  // NOTE: documentation says 60 s for max response time but that is for the URC, "OK"/"ERROR" response should be fast
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
-            LogError( ( "Cellular_SocketConnect: Socket connect failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+            LogError( ( "Cellular_GetHostByName: couldn't resolve host name" ) );
             cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
 
-            /* Revert the state to allocated state. */
-            socketHandle->socketState = SOCKETSTATE_ALLOCATED;
+            /* Still the newest query, no URC will follow for it. */
+            PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
+            pQuery->pending = false;
+            PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
         }
-    }
 
-    return cellularStatus;
-}
+        PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
 
-/*-----------------------------------------------------------*/
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            _releaseDnsQuery( pModuleContext, pQuery );
+        }
+    }
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-/* coverity[misra_c_2012_rule_8_13_violation] */
-CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
-                                       CellularPdnStatus_t * pPdnStatusBuffers,
-                                       uint8_t numStatusBuffers,
-                                       uint8_t * pNumStatus )
-{
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    const CellularPdnStatus_t * pTempPdnStatusBuffer = pPdnStatusBuffers;
-    uint8_t numBuffers = 0;
-    CellularAtReq_t atReqGetPdnStatus =
+    /* URC handler calls the callback to unblock this function. */
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
     {
-        "AT+QIACT?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QIACT",
-        _Cellular_RecvFuncGetPdnStatus,
-        pPdnStatusBuffers,
-        numStatusBuffers,
-    };
+        /* An expired deadline still polls the queue once, the URC may already be there. */
+        if( _getDeadlineBoundedTimeoutMs( pDeadlineTicks, queryTimeoutMs, &queryTimeoutMs ) != CELLULAR_SUCCESS )
+        {
+            queryTimeoutMs = 0U;
+        }
 
-    if( ( pTempPdnStatusBuffer == NULL ) || ( pNumStatus == NULL ) || ( numStatusBuffers < 1u ) )
-    {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-        LogWarn( ( "_Cellular_GetPdnStatus: Bad input Parameter " ) );
-    }
+        if( _Cellular_QueueReceive( pQuery->resultQueue, &dnsQueryCompletion,
+                                    pdMS_TO_TICKS( queryTimeoutMs ) ) != pdTRUE )
+        {
+            /* The result may complete between the timeout and the release, check again under the lock. */
+            PlatformMutex_Lock( &pModuleContext->dnsPendingMutex );
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
-    }
+            if( xQueueReceive( pQuery->resultQueue, &dnsQueryCompletion, ( TickType_t ) 0 ) != pdTRUE )
+            {
+                pQuery->pResolvedAddress = NULL;
+                pQuery->pResolvedAddresses = NULL;
+                cellularStatus = CELLULAR_TIMEOUT;
+            }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPdnStatus );
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-    }
+            PlatformMutex_Unlock( &pModuleContext->dnsPendingMutex );
+        }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Populate the Valid number of statuses. */
-        *pNumStatus = 0;
-        numBuffers = numStatusBuffers;
+        _releaseDnsQuery( pModuleContext, pQuery );
 
-        while( numBuffers != 0U )
+        if( cellularStatus != CELLULAR_SUCCESS )
         {
-            /* Check if the PDN state is valid. The context ID of the first
-             * invalid PDN status is set to FF. */
-            if( ( pTempPdnStatusBuffer->contextId != INVALID_PDN_INDEX ) &&
-                ( pTempPdnStatusBuffer->contextId >= CELLULAR_PDN_CONTEXT_ID_MIN ) &&
-                ( pTempPdnStatusBuffer->contextId <= CELLULAR_PDN_CONTEXT_ID_MAX ) )
+            LogWarn( ( "Cellular_GetHostByName: %s timed out", pcHostName ) );
+        }
+        else if( dnsQueryCompletion.result != CELLULAR_DNS_QUERY_SUCCESS )
+        {
+            cellularStatus = CELLULAR_UNKNOWN;
+
+            /* Only answers from the DNS server are held down, a garbled URC is not the server's verdict. */
+            if( ( useCache ) && ( dnsQueryCompletion.resultCode >= 0 ) )
             {
-                ( *pNumStatus ) += 1U;
+                _Cellular_DnsCacheInsertFailure( pModuleContext, contextId, pcHostName, dnsQueryCompletion.resultCode );
             }
-            else
+        }
+        else if( useCache == false )
+        {
+            if( pResolvedAddresses != NULL )
             {
-                break;
+                *pAddressCount = dnsQueryCompletion.addressCount;
             }
-
-            numBuffers--;
-            pTempPdnStatusBuffer++;
+        }
+        else if( pResolvedAddresses != NULL )
+        {
+            *pAddressCount = dnsQueryCompletion.addressCount;
+            _Cellular_DnsCacheInsert( pModuleContext, contextId, pcHostName, pResolvedAddresses[ 0 ].ipAddress,
+                                      dnsQueryCompletion.timeToLiveSeconds );
+        }
+        else
+        {
+            _Cellular_DnsCacheInsert( pModuleContext, contextId, pcHostName, pResolvedAddress,
+                                      dnsQueryCompletion.timeToLiveSeconds );
         }
     }
 
@@ -4105,58 +6096,79 @@ CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
-                                           CellularSimCardStatus_t * pSimCardStatus )
+CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        char * pResolvedAddress )
+{
+    return _Cellular_GetHostByName( ( CellularContext_t * ) cellularHandle, contextId, pcHostName,
+                                    pResolvedAddress, NULL, 0, NULL, CELLULAR_AT_PRIORITY_DATA, true, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetHostByNameWithDeadline( CellularHandle_t cellularHandle,
+                                                    uint8_t contextId,
+                                                    const char * pcHostName,
+                                                    char * pResolvedAddress,
+                                                    TickType_t deadlineTicks )
+{
+    return _Cellular_GetHostByName( ( CellularContext_t * ) cellularHandle, contextId, pcHostName,
+                                    pResolvedAddress, NULL, 0, NULL, CELLULAR_AT_PRIORITY_DATA, true, &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetHostByNameMultiple( CellularHandle_t cellularHandle,
+                                                uint8_t contextId,
+                                                const char * pcHostName,
+                                                CellularIPAddress_t * pResolvedAddresses,
+                                                uint8_t maxAddressCount,
+                                                uint8_t * pAddressCount )
+{
+    return _Cellular_GetHostByName( ( CellularContext_t * ) cellularHandle, contextId, pcHostName,
+                                    NULL, pResolvedAddresses, maxAddressCount, pAddressCount,
+                                    CELLULAR_AT_PRIORITY_DATA, true, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_RefreshDnsCache( CellularHandle_t cellularHandle )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularAtReq_t atReqGetSimCardStatus =
-    {
-        "AT+QSIMSTAT?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QSIMSTAT",
-        _Cellular_RecvFuncGetSimCardStatus,
-        &pSimCardStatus->simCardState,
-        sizeof( CellularSimCardState_t ),
-    };
-    CellularAtReq_t atReqGetSimLockStatus =
-    {
-        "AT+CPIN?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CPIN",
-        _Cellular_RecvFuncGetSimLockStatus,
-        &pSimCardStatus->simCardLockState,
-        sizeof( CellularSimCardLockState_t ),
-    };
+    CellularError_t refreshStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    char hostName[ CELLULAR_BG770_DNS_CACHE_HOST_NAME_MAX_SIZE + 1U ] = { '\0' };
+    CellularIPAddress_t resolvedAddress = { 0 };
+    uint8_t addressCount = 0;
+    uint8_t contextId = 0;
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
-    }
-    else if( pSimCardStatus == NULL )
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
-    else
-    {
-        /* Initialize the sim state and the sim lock state. */
-        pSimCardStatus->simCardState = CELLULAR_SIM_CARD_UNKNOWN;
-        pSimCardStatus->simCardLockState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
 
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimCardStatus );
+    /* Each candidate is attempted once per cache insertion, a failed refresh leaves the entry to expire. */
+    while( ( cellularStatus == CELLULAR_SUCCESS ) &&
+           _Cellular_DnsCacheGetRefreshCandidate( pModuleContext, &contextId, hostName ) )
+    {
+        /* The background class yields to connections and control requests, the refresh uses idle AT time. */
+        refreshStatus = _Cellular_GetHostByName( pContext, contextId, hostName, NULL, &resolvedAddress, 1U,
+                                                 &addressCount, CELLULAR_AT_PRIORITY_BACKGROUND, true, NULL );
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        if( refreshStatus != CELLULAR_SUCCESS )
         {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimLockStatus );
+            LogWarn( ( "Cellular_RefreshDnsCache: refresh of %s failed, status: %d", hostName, refreshStatus ) );
         }
 
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-        LogDebug( ( "_Cellular_GetSimStatus, Sim Insert State[%d], Lock State[%d]",
-                    pSimCardStatus->simCardState, pSimCardStatus->simCardLockState ) );
+        _Cellular_DnsCacheRefreshDone( pModuleContext, contextId, hostName, refreshStatus == CELLULAR_SUCCESS );
     }
 
     return cellularStatus;
@@ -4164,42 +6176,16 @@ CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
-                                         CellularSimCardInfo_t * pSimCardInfo )
+CellularError_t Cellular_SetDnsCandidates( CellularHandle_t cellularHandle,
+                                           uint8_t contextId,
+                                           const char * const * ppServerAddresses,
+                                           uint8_t serverCount )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-
-    CellularAtReq_t atReqGetIccid =
-    {
-        "AT+QCCID",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QCCID",
-        _Cellular_RecvFuncGetIccid,
-        pSimCardInfo->iccid,
-        CELLULAR_ICCID_MAX_SIZE + 1U,
-    };
-    CellularAtReq_t atReqGetImsi =
-    {
-        "AT+CIMI",
-        CELLULAR_AT_WO_PREFIX,
-        NULL,
-        _Cellular_RecvFuncGetImsi,
-        pSimCardInfo->imsi,
-        CELLULAR_IMSI_MAX_SIZE + 1U,
-    };
-    CellularAtReq_t atReqGetHplmn =
-    {
-        "AT+CRSM=176,28514,0,0,0",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CRSM",
-        _Cellular_RecvFuncGetHplmn,
-        &pSimCardInfo->plmn,
-        sizeof( CellularPlmnInfo_t ),
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint8_t i = 0;
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
@@ -4208,35 +6194,57 @@ CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pSimCardInfo == NULL )
+    else if( ( ppServerAddresses == NULL ) || ( serverCount == 0U ) ||
+             ( serverCount > CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES ) )
     {
+        LogError( ( "Cellular_SetDnsCandidates: Invalid parameter" ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        ( void ) memset( pSimCardInfo, 0, sizeof( CellularSimCardInfo_t ) );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetImsi );
+        cellularStatus = _Cellular_IsValidPdn( contextId );
+    }
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+    for( i = 0; ( cellularStatus == CELLULAR_SUCCESS ) && ( i < serverCount ); i++ )
+    {
+        if( ( ppServerAddresses[ i ] == NULL ) || ( strlen( ppServerAddresses[ i ] ) > CELLULAR_IP_ADDRESS_MAX_SIZE ) )
         {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetHplmn );
+            LogError( ( "Cellular_SetDnsCandidates: Invalid server address at index %u", i ) );
+            cellularStatus = CELLULAR_BAD_PARAMETER;
         }
+    }
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
-        {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetIccid );
-        }
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+
+        if( pModuleContext->dnsProbeInProgress )
         {
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            cellularStatus = CELLULAR_NOT_ALLOWED;
         }
         else
         {
-            LogDebug( ( "SimInfo updated: IMSI:%s, Hplmn:%s%s, ICCID:%s",
-                        pSimCardInfo->imsi, pSimCardInfo->plmn.mcc, pSimCardInfo->plmn.mnc,
-                        pSimCardInfo->iccid ) );
+            ( void ) memset( pModuleContext->dnsServerScores, 0, sizeof( pModuleContext->dnsServerScores ) );
+
+            for( i = 0; i < serverCount; i++ )
+            {
+                ( void ) strncpy( pModuleContext->dnsServerScores[ i ].serverAddress, ppServerAddresses[ i ],
+                                  CELLULAR_IP_ADDRESS_MAX_SIZE );
+            }
+
+            /* Until the first probe the configured order is assumed. */
+            pModuleContext->dnsServerCount = serverCount;
+            pModuleContext->dnsServerContextId = contextId;
+            pModuleContext->dnsPrimaryServerIndex = 0;
+            pModuleContext->dnsSecondaryServerIndex = ( serverCount > 1U ) ? 1U : CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES;
         }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
     }
 
     return cellularStatus;
@@ -4244,58 +6252,96 @@ CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandle_t cellularHandle,
-                                                                   CellularUrcSignalStrengthChangedCallback_t signalStrengthChangedCallback,
-                                                                   void * pCallbackContext )
+/* Must be called with dnsCacheMutex held. */
+static void _updateDnsServerScore( CellularDnsServerScore_t * pScore,
+                                   bool probeSucceeded,
+                                   uint32_t latencyMs )
 {
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    /* A failed probe counts as a query that ran into the timeout. */
+    const uint32_t sampleMs = ( probeSucceeded ) ? latencyMs : DNS_QUERY_TIMEOUT_MS;
 
-    /* pContext is checked in the common library. */
-    cellularStatus = Cellular_CommonRegisterUrcSignalStrengthChangedCallback(
-        cellularHandle, signalStrengthChangedCallback, pCallbackContext );
+    if( pScore->probeCount == 0U )
+    {
+        pScore->latencyScoreMs = sampleMs;
+    }
+    else
+    {
+        pScore->latencyScoreMs = ( ( pScore->latencyScoreMs * ( DNS_SERVER_SCORE_WEIGHT - 1U ) ) + sampleMs ) /
+                                 DNS_SERVER_SCORE_WEIGHT;
+    }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+    pScore->probeCount++;
+    pScore->lastLatencyMs = sampleMs;
+
+    if( probeSucceeded == false )
     {
-        if( signalStrengthChangedCallback != NULL )
+        pScore->failureCount++;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Must be called with dnsCacheMutex held. Moves the selection to the two best scores, but only when the best
+ * server beats the current primary by the configured margin so that noise does not reprogram the modem. */
+static void _selectDnsServers( cellularModuleContext_t * pModuleContext )
+{
+    const CellularDnsServerScore_t * pScores = pModuleContext->dnsServerScores;
+    uint8_t bestIndex = CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES;
+    uint8_t secondIndex = CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES;
+    uint8_t i = 0;
+
+    for( i = 0; i < pModuleContext->dnsServerCount; i++ )
+    {
+        if( ( bestIndex == CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES ) ||
+            ( pScores[ i ].latencyScoreMs < pScores[ bestIndex ].latencyScoreMs ) )
         {
-            cellularStatus = controlSignalStrengthIndication( pContext, true );
+            secondIndex = bestIndex;
+            bestIndex = i;
+        }
+        else if( ( secondIndex == CELLULAR_BG770_DNS_MAX_SERVER_CANDIDATES ) ||
+                 ( pScores[ i ].latencyScoreMs < pScores[ secondIndex ].latencyScoreMs ) )
+        {
+            secondIndex = i;
         }
         else
         {
-            cellularStatus = controlSignalStrengthIndication( pContext, false );
+            /* Not among the two best. */
         }
     }
-
-    return cellularStatus;
+
+    if( ( bestIndex != pModuleContext->dnsPrimaryServerIndex ) &&
+        ( ( ( uint64_t ) pScores[ bestIndex ].latencyScoreMs * 100U ) <
+          ( ( uint64_t ) pScores[ pModuleContext->dnsPrimaryServerIndex ].latencyScoreMs *
+            ( 100U - CELLULAR_BG770_DNS_RESELECT_MARGIN_PERCENT ) ) ) )
+    {
+        LogInfo( ( "_selectDnsServers: primary DNS server %s -> %s, score %lu ms -> %lu ms",
+                   pScores[ pModuleContext->dnsPrimaryServerIndex ].serverAddress, pScores[ bestIndex ].serverAddress,
+                   pScores[ pModuleContext->dnsPrimaryServerIndex ].latencyScoreMs, pScores[ bestIndex ].latencyScoreMs ) );
+        pModuleContext->dnsPrimaryServerIndex = bestIndex;
+        pModuleContext->dnsSecondaryServerIndex = secondIndex;
+        pModuleContext->dnsServerSwitchCount++;
+    }
 }
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
-                                        uint8_t contextId,
-                                        const char * pcHostName,
-                                        char * pResolvedAddress )
+CellularError_t Cellular_ProbeDnsServers( CellularHandle_t cellularHandle,
+                                          const char * pProbeHostName )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE ];
-    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    CellularError_t probeStatus = CELLULAR_SUCCESS;
     cellularModuleContext_t * pModuleContext = NULL;
-    CellularAtReq_t atReqQueryDns =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+    char primaryServer[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ] = { '\0' };
+    char secondaryServer[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ] = { '\0' };
+    CellularIPAddress_t probeAddress = { 0 };
+    uint8_t addressCount = 0;
+    uint8_t serverCount = 0;
+    uint8_t contextId = 0;
+    uint8_t i = 0;
+    TickType_t startTicks = 0;
+    uint32_t latencyMs = 0;
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
@@ -4304,65 +6350,91 @@ CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( ( pcHostName == NULL ) || ( pResolvedAddress == NULL ) )
+    else if( pProbeHostName == NULL )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
-    {
-        cellularStatus = _Cellular_IsValidPdn( contextId );
-    }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
     {
         cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
-        pModuleContext->dnsResultNumber = 0;
-        pModuleContext->dnsIndex = 0;
-        ( void ) xQueueReset( pModuleContext->pktDnsQueue );
-        cellularStatus = registerDnsEventCallback( pModuleContext, _dnsResultCallback, pResolvedAddress );
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+
+        if( pModuleContext->dnsServerCount == 0U )
+        {
+            LogError( ( "Cellular_ProbeDnsServers: no candidates, call Cellular_SetDnsCandidates first" ) );
+            cellularStatus = CELLULAR_BAD_PARAMETER;
+        }
+        else if( pModuleContext->dnsProbeInProgress )
+        {
+            cellularStatus = CELLULAR_NOT_ALLOWED;
+        }
+        else
+        {
+            pModuleContext->dnsProbeInProgress = true;
+            serverCount = pModuleContext->dnsServerCount;
+            contextId = pModuleContext->dnsServerContextId;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
     }
 
-    /* Send the AT command and wait the URC result. */
-    if( cellularStatus == CELLULAR_SUCCESS )
+    /* Each candidate is programmed alone and timed with an uncached query. */
+    for( i = 0; ( cellularStatus == CELLULAR_SUCCESS ) && ( i < serverCount ); i++ )
     {
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        /* coverity[misra_c_2012_rule_21_6_violation]. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE,
-                           "AT+QIDNSGIP=%u,\"%s\"", contextId, pcHostName );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQueryDns );  // NOTE: documentation says 60 s for max response time but that is for the URC, "OK"/"ERROR" response should be fast
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+        ( void ) strncpy( primaryServer, pModuleContext->dnsServerScores[ i ].serverAddress, CELLULAR_IP_ADDRESS_MAX_SIZE );
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        probeStatus = Cellular_SetDns( cellularHandle, contextId, primaryServer, NULL );
+        startTicks = _Cellular_GetTicks();
+
+        if( probeStatus == CELLULAR_SUCCESS )
         {
-            LogError( ( "Cellular_GetHostByName: couldn't resolve host name" ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-            PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+            probeStatus = _Cellular_GetHostByName( pContext, contextId, pProbeHostName, NULL, &probeAddress, 1U,
+                                                   &addressCount, CELLULAR_AT_PRIORITY_BACKGROUND, false, NULL );
         }
+
+        latencyMs = ( uint32_t ) ( ( ( uint64_t ) ( _Cellular_GetTicks() - startTicks ) * 1000U ) /
+                                   ( uint64_t ) configTICK_RATE_HZ );
+        LogDebug( ( "Cellular_ProbeDnsServers: %s status %d, %lu ms", primaryServer, probeStatus, latencyMs ) );
+
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+        _updateDnsServerScore( &pModuleContext->dnsServerScores[ i ], probeStatus == CELLULAR_SUCCESS, latencyMs );
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
     }
 
-    /* URC handler calls the callback to unblock this function. */
-    if( cellularStatus == CELLULAR_SUCCESS )
+    /* Probing left the last candidate programmed, the selected pair is always written back. */
+    if( serverCount > 0U )
     {
-        if( xQueueReceive( pModuleContext->pktDnsQueue, &dnsQueryResult,
-                           pdMS_TO_TICKS( DNS_QUERY_TIMEOUT_MS ) ) == pdTRUE )
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            if( dnsQueryResult != CELLULAR_DNS_QUERY_SUCCESS )
-            {
-                cellularStatus = CELLULAR_UNKNOWN;
-            }
+            _selectDnsServers( pModuleContext );
         }
-        else
+
+        ( void ) strncpy( primaryServer, pModuleContext->dnsServerScores[ pModuleContext->dnsPrimaryServerIndex ].serverAddress,
+                          CELLULAR_IP_ADDRESS_MAX_SIZE );
+
+        if( pModuleContext->dnsSecondaryServerIndex < pModuleContext->dnsServerCount )
         {
-            ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-            cellularStatus = CELLULAR_TIMEOUT;
+            ( void ) strncpy( secondaryServer,
+                              pModuleContext->dnsServerScores[ pModuleContext->dnsSecondaryServerIndex ].serverAddress,
+                              CELLULAR_IP_ADDRESS_MAX_SIZE );
         }
 
-        PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
+
+        cellularStatus = Cellular_SetDns( cellularHandle, contextId, primaryServer,
+                                          ( secondaryServer[ 0 ] != '\0' ) ? secondaryServer : NULL );
+
+        PlatformMutex_Lock( &pModuleContext->dnsCacheMutex );
+        pModuleContext->dnsProbeInProgress = false;
+        PlatformMutex_Unlock( &pModuleContext->dnsCacheMutex );
     }
 
     return cellularStatus;
@@ -6246,6 +8318,7 @@ CellularError_t Cellular_PowerDown( CellularHandle_t cellularHandle,
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
     CellularAtReq_t atReqPowerDown = { 0 };
+    TickType_t deadlineTicks = 0;
     uint8_t mode = 1;
 
     atReqPowerDown.pAtCmd = cmdBuf;
@@ -6290,7 +8363,11 @@ CellularError_t Cellular_PowerDown( CellularHandle_t cellularHandle,
                                "AT+QPOWD=",
                                mode );
             LogDebug( ( "Cellular_PowerDown: power down command: %s", cmdBuf ) );
-            pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqPowerDown );
+
+            /* An in-flight request cannot be preempted, waiting for it is bounded by the command timeout. */
+            deadlineTicks = _Cellular_GetTicks() + pdMS_TO_TICKS( PACKET_REQ_TIMEOUT_MS );
+            pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_CONTROL, atReqPowerDown,
+                                                                  PACKET_REQ_TIMEOUT_MS, &deadlineTicks );
 
             if( pktStatus != CELLULAR_PKT_STATUS_OK )
             {
@@ -6313,6 +8390,7 @@ CellularError_t Cellular_SetPSMEntry( CellularHandle_t cellularHandle,
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
     CellularAtReq_t atReqSetPSMEnter = { 0 };
+    TickType_t deadlineTicks = 0;
     uint8_t mode = 1;
 
     atReqSetPSMEnter.pAtCmd = cmdBuf;
@@ -6342,28 +8420,328 @@ CellularError_t Cellular_SetPSMEntry( CellularHandle_t cellularHandle,
                 mode = 1;
                 break;
 
-            default:
-                LogError( ( "Cellular_SetPSMEntry: invalid PSM enter mode requested, mode: %d", psmEnterMode ) );
-                cellularStatus = CELLULAR_BAD_PARAMETER;
-                break;
+            default:
+                LogError( ( "Cellular_SetPSMEntry: invalid PSM enter mode requested, mode: %d", psmEnterMode ) );
+                cellularStatus = CELLULAR_BAD_PARAMETER;
+                break;
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* MISRA Ref 21.6.1 [Use of snprintf] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Cellular-Interface/blob/main/MISRA.md#rule-216 */
+            /* coverity[misra_c_2012_rule_21_6_violation]. */
+            ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "%s%d",
+                               "AT+QCFG=\"psm/enter\",",
+                               mode );
+            LogDebug( ( "Cellular_SetPSMEntry: PSM enter command: %s", cmdBuf ) );
+
+            /* An in-flight request cannot be preempted, waiting for it is bounded by the command timeout. */
+            deadlineTicks = _Cellular_GetTicks() + pdMS_TO_TICKS( PACKET_REQ_TIMEOUT_MS );
+            pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_CONTROL, atReqSetPSMEnter,
+                                                                  PACKET_REQ_TIMEOUT_MS, &deadlineTicks );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_SetPSMEntry: couldn't send PSM enter mode" ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            }
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* NB-S1 mode interprets the values it does not define as 0010. */
+static uint32_t _getEdrxCycleMs( uint8_t actType,
+                                 uint8_t edrxValue )
+{
+    uint8_t value = edrxValue & 0x0FU;
+
+    if( ( actType == ( uint8_t ) EDRX_ACT_TYPE_NB_S1 ) &&
+        ( ( value <= 1U ) || ( value == 4U ) || ( ( value >= 6U ) && ( value <= 8U ) ) ) )
+    {
+        value = 2U;
+    }
+
+    return EDRX_CYCLE_MS[ value ];
+}
+
+/*-----------------------------------------------------------*/
+
+/* +CEDRXRDP: <AcT-type>[,<Requested_eDRX_value>[,<NW-provided_eDRX_value>[,<Paging_time_window>]]] */
+static bool _parseEdrxRdp( char * pEdrxRdpPayload,
+                           CellularEdrxTimeline_t * pEdrxTimeline )
+{
+    char * pToken = NULL;
+    char * pTmpEdrxRdpPayload = pEdrxRdpPayload;
+    int32_t actType = 0;
+    uint32_t tempValue = 0;
+    bool parseStatus = false;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+
+    atCoreStatus = Cellular_ATRemoveAllDoubleQuote( pTmpEdrxRdpPayload );
+
+    if( atCoreStatus == CELLULAR_AT_SUCCESS )
+    {
+        atCoreStatus = Cellular_ATGetNextTok( &pTmpEdrxRdpPayload, &pToken );
+    }
+
+    if( atCoreStatus == CELLULAR_AT_SUCCESS )
+    {
+        atCoreStatus = Cellular_ATStrtoi( pToken, 10, &actType );
+    }
+
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( actType >= 0 ) && ( actType <= ( int32_t ) UINT8_MAX ) )
+    {
+        pEdrxTimeline->actType = ( uint8_t ) actType;
+        pEdrxTimeline->edrxActive = false;
+        parseStatus = true;
+
+        /* The eDRX values are 4 bit strings, missing ones mean eDRX is not in use. */
+        if( ( actType != EDRX_ACT_TYPE_NOT_USED ) &&
+            ( Cellular_ATGetNextTok( &pTmpEdrxRdpPayload, &pToken ) == CELLULAR_AT_SUCCESS ) &&
+            ( Cellular_ATStrtoui( pToken, 2, &tempValue ) == CELLULAR_AT_SUCCESS ) )
+        {
+            pEdrxTimeline->requestedEdrxValue = ( uint8_t ) ( tempValue & 0x0FU );
+
+            if( ( Cellular_ATGetNextTok( &pTmpEdrxRdpPayload, &pToken ) == CELLULAR_AT_SUCCESS ) &&
+                ( Cellular_ATStrtoui( pToken, 2, &tempValue ) == CELLULAR_AT_SUCCESS ) )
+            {
+                pEdrxTimeline->nwProvidedEdrxValue = ( uint8_t ) ( tempValue & 0x0FU );
+                pEdrxTimeline->edrxCycleMs = _getEdrxCycleMs( pEdrxTimeline->actType, pEdrxTimeline->nwProvidedEdrxValue );
+                pEdrxTimeline->edrxActive = true;
+            }
+
+            if( ( pEdrxTimeline->edrxActive ) &&
+                ( Cellular_ATGetNextTok( &pTmpEdrxRdpPayload, &pToken ) == CELLULAR_AT_SUCCESS ) &&
+                ( Cellular_ATStrtoui( pToken, 2, &tempValue ) == CELLULAR_AT_SUCCESS ) )
+            {
+                pEdrxTimeline->pagingTimeWindowValue = ( uint8_t ) ( tempValue & 0x0FU );
+                pEdrxTimeline->pagingTimeWindowMs = ( ( uint32_t ) pEdrxTimeline->pagingTimeWindowValue + 1U ) *
+                                                    ( ( pEdrxTimeline->actType == ( uint8_t ) EDRX_ACT_TYPE_NB_S1 ) ?
+                                                      EDRX_PTW_UNIT_NB_S1_MS : EDRX_PTW_UNIT_WB_S1_MS );
+            }
+        }
+    }
+    else
+    {
+        LogError( ( "_parseEdrxRdp: Error in processing AcT-type" ) );
+    }
+
+    return parseStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_13_violation] */
+static CellularPktStatus_t _Cellular_RecvFuncGetEdrxRdp( CellularContext_t * pContext,
+                                                         const CellularATCommandResponse_t * pAtResp,
+                                                         void * pData,
+                                                         uint16_t dataLen )
+{
+    char * pInputLine = NULL;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    CellularEdrxTimeline_t * pEdrxTimeline = ( CellularEdrxTimeline_t * ) pData;
+
+    if( pContext == NULL )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+    }
+    else if( ( pAtResp == NULL ) || ( pAtResp->pItm == NULL ) || ( pAtResp->pItm->pLine == NULL ) )
+    {
+        LogError( ( "GetEdrxRdp: response is invalid" ) );
+        pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+    }
+    else if( ( pData == NULL ) || ( dataLen != sizeof( CellularEdrxTimeline_t ) ) )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else
+    {
+        pInputLine = pAtResp->pItm->pLine;
+        atCoreStatus = Cellular_ATRemovePrefix( &pInputLine );
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pInputLine );
+        }
+
+        if( atCoreStatus != CELLULAR_AT_SUCCESS )
+        {
+            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+        }
+        else if( _parseEdrxRdp( pInputLine, pEdrxTimeline ) == false )
+        {
+            pktStatus = CELLULAR_PKT_STATUS_BAD_RESPONSE;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+    return pktStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Windows repeat every eDRX cycle from the anchor and last one paging time window. */
+static uint32_t _getPagingWindowWaitMs( CellularEdrxTimeline_t * pEdrxTimeline,
+                                        TickType_t nowTicks )
+{
+    uint32_t waitMs = 0;
+    uint32_t phaseMs = 0;
+
+    if( ( pEdrxTimeline->edrxActive ) && ( pEdrxTimeline->anchorKnown ) && ( pEdrxTimeline->edrxCycleMs != 0U ) &&
+        ( pEdrxTimeline->pagingTimeWindowMs < pEdrxTimeline->edrxCycleMs ) )
+    {
+        phaseMs = ( uint32_t ) ( ( ( ( uint64_t ) ( nowTicks - pEdrxTimeline->anchorTicks ) * 1000U ) /
+                                   ( uint64_t ) configTICK_RATE_HZ ) % pEdrxTimeline->edrxCycleMs );
+
+        if( phaseMs >= pEdrxTimeline->pagingTimeWindowMs )
+        {
+            waitMs = pEdrxTimeline->edrxCycleMs - phaseMs;
+        }
+    }
+
+    pEdrxTimeline->inPagingWindow = ( waitMs == 0U );
+    pEdrxTimeline->nextPagingWindowMs = waitMs;
+
+    return waitMs;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_EdrxNotePaged( const CellularContext_t * pContext )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->edrxMutex );
+        pModuleContext->edrxTimeline.anchorKnown = true;
+        pModuleContext->edrxTimeline.anchorTicks = _Cellular_GetTicks();
+        PlatformMutex_Unlock( &pModuleContext->edrxMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetNegotiatedEdrx( CellularHandle_t cellularHandle,
+                                            CellularEdrxTimeline_t * pEdrxTimeline )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularEdrxTimeline_t edrxRdp = { 0 };
+    CellularAtReq_t atReqGetEdrxRdp =
+    {
+        "AT+CEDRXRDP",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CEDRXRDP",
+        _Cellular_RecvFuncGetEdrxRdp,
+        &edrxRdp,
+        sizeof( CellularEdrxTimeline_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogError( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pEdrxTimeline == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqGetEdrxRdp,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_GetNegotiatedEdrx: couldn't retrieve eDRX parameters" ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* The anchor and counters are kept across reads. */
+        PlatformMutex_Lock( &pModuleContext->edrxMutex );
+        pModuleContext->edrxTimeline.edrxActive = edrxRdp.edrxActive;
+        pModuleContext->edrxTimeline.actType = edrxRdp.actType;
+        pModuleContext->edrxTimeline.requestedEdrxValue = edrxRdp.requestedEdrxValue;
+        pModuleContext->edrxTimeline.nwProvidedEdrxValue = edrxRdp.nwProvidedEdrxValue;
+        pModuleContext->edrxTimeline.pagingTimeWindowValue = edrxRdp.pagingTimeWindowValue;
+        pModuleContext->edrxTimeline.edrxCycleMs = edrxRdp.edrxCycleMs;
+        pModuleContext->edrxTimeline.pagingTimeWindowMs = edrxRdp.pagingTimeWindowMs;
+        ( void ) _getPagingWindowWaitMs( &pModuleContext->edrxTimeline, _Cellular_GetTicks() );
+        *pEdrxTimeline = pModuleContext->edrxTimeline;
+        PlatformMutex_Unlock( &pModuleContext->edrxMutex );
+
+        LogDebug( ( "Cellular_GetNegotiatedEdrx: eDRX %d, cycle %lu ms, PTW %lu ms",
+                    edrxRdp.edrxActive, edrxRdp.edrxCycleMs, edrxRdp.pagingTimeWindowMs ) );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_WaitForPagingWindow( CellularHandle_t cellularHandle,
+                                              uint32_t maxWaitMs )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint32_t waitMs = 0;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->edrxMutex );
+        waitMs = _getPagingWindowWaitMs( &pModuleContext->edrxTimeline, _Cellular_GetTicks() );
+
+        if( waitMs > maxWaitMs )
+        {
+            waitMs = maxWaitMs;
+            cellularStatus = CELLULAR_TIMEOUT;
         }
 
-        if( cellularStatus == CELLULAR_SUCCESS )
+        if( waitMs > 0U )
         {
-            /* MISRA Ref 21.6.1 [Use of snprintf] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Cellular-Interface/blob/main/MISRA.md#rule-216 */
-            /* coverity[misra_c_2012_rule_21_6_violation]. */
-            ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "%s%d",
-                               "AT+QCFG=\"psm/enter\",",
-                               mode );
-            LogDebug( ( "Cellular_SetPSMEntry: PSM enter command: %s", cmdBuf ) );
-            pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqSetPSMEnter );
+            pModuleContext->edrxTimeline.heldCount++;
+            pModuleContext->edrxTimeline.heldTotalMs += waitMs;
+        }
 
-            if( pktStatus != CELLULAR_PKT_STATUS_OK )
-            {
-                LogError( ( "Cellular_SetPSMEntry: couldn't send PSM enter mode" ) );
-                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-            }
+        PlatformMutex_Unlock( &pModuleContext->edrxMutex );
+
+        if( waitMs > 0U )
+        {
+            LogDebug( ( "Cellular_WaitForPagingWindow: holding for %lu ms", waitMs ) );
+            _Cellular_DelayTicks( pdMS_TO_TICKS( waitMs ) );
         }
     }
 
@@ -6617,12 +8995,15 @@ static CellularPktStatus_t _Cellular_RecvFuncGetServiceSelection( CellularContex
     return pktStatus;
 }
 
-CellularError_t Cellular_GetServiceSelection( CellularHandle_t cellularHandle,
-                                              CellularServiceSelection_t * pServiceSelection )
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_GetServiceSelection( CellularContext_t * pContext,
+                                                      CellularServiceSelection_t * pServiceSelection,
+                                                      const TickType_t * pDeadlineTicks )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t timeoutMs = OPERATOR_SELECTION_PACKET_REQ_TIMEOUT_MS;
     CellularAtReq_t atReqGetServiceSelection =
     {
         "AT+COPS?",
@@ -6645,7 +9026,12 @@ CellularError_t Cellular_GetServiceSelection( CellularHandle_t cellularHandle,
     }
     else
     {
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback(pContext, atReqGetServiceSelection, OPERATOR_SELECTION_PACKET_REQ_TIMEOUT_MS );
+        cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &timeoutMs );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback(pContext, atReqGetServiceSelection, timeoutMs );
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
@@ -6659,12 +9045,31 @@ CellularError_t Cellular_GetServiceSelection( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SetServiceSelection( CellularHandle_t cellularHandle,
-                                              const CellularServiceSelection_t *const pServiceSelection )
+CellularError_t Cellular_GetServiceSelection( CellularHandle_t cellularHandle,
+                                              CellularServiceSelection_t * pServiceSelection )
+{
+    return _Cellular_GetServiceSelection( ( CellularContext_t * ) cellularHandle, pServiceSelection, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetServiceSelectionWithDeadline( CellularHandle_t cellularHandle,
+                                                          CellularServiceSelection_t * pServiceSelection,
+                                                          TickType_t deadlineTicks )
+{
+    return _Cellular_GetServiceSelection( ( CellularContext_t * ) cellularHandle, pServiceSelection,
+                                          &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t _Cellular_SetServiceSelection( CellularContext_t * pContext,
+                                                      const CellularServiceSelection_t * pServiceSelection,
+                                                      const TickType_t * pDeadlineTicks )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t timeoutMs = OPERATOR_SELECTION_PACKET_REQ_TIMEOUT_MS;
     char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
     CellularAtReq_t atReqSetServiceSelection = { 0 };
     uint8_t mode = 0;
@@ -6774,6 +9179,11 @@ CellularError_t Cellular_SetServiceSelection( CellularHandle_t cellularHandle,
             }
         }
 
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = _getDeadlineBoundedTimeoutMs( pDeadlineTicks, timeoutMs, &timeoutMs );
+        }
+
         if( cellularStatus == CELLULAR_SUCCESS )
         {
             /* MISRA Ref 21.6.1 [Use of snprintf] */
@@ -6782,7 +9192,7 @@ CellularError_t Cellular_SetServiceSelection( CellularHandle_t cellularHandle,
             ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "%s%d,%d,\"%s\"%s",
                                "AT+COPS=", mode, pServiceSelection->operatorNameFormat, operatorString, commaRATString );
             LogDebug( ( "Cellular_SetPSMEntry: PSM enter command: %s", cmdBuf ) );
-            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSetServiceSelection, OPERATOR_SELECTION_PACKET_REQ_TIMEOUT_MS );
+            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSetServiceSelection, timeoutMs );
 
             if( pktStatus != CELLULAR_PKT_STATUS_OK )
             {
@@ -6797,6 +9207,24 @@ CellularError_t Cellular_SetServiceSelection( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
+CellularError_t Cellular_SetServiceSelection( CellularHandle_t cellularHandle,
+                                              const CellularServiceSelection_t *const pServiceSelection )
+{
+    return _Cellular_SetServiceSelection( ( CellularContext_t * ) cellularHandle, pServiceSelection, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SetServiceSelectionWithDeadline( CellularHandle_t cellularHandle,
+                                                          const CellularServiceSelection_t *const pServiceSelection,
+                                                          TickType_t deadlineTicks )
+{
+    return _Cellular_SetServiceSelection( ( CellularContext_t * ) cellularHandle, pServiceSelection,
+                                          &deadlineTicks );
+}
+
+/*-----------------------------------------------------------*/
+
 static bool _parseFrequencyBands( char * pQcfgBandsPayload,
                                   _bg770FrequencyBands_t * pFrequencyBands )
 {
@@ -7665,128 +10093,537 @@ static bool _parseBoardTemperatures( char * pQTempPayload,
         {
             atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
 
-            if( atCoreStatus == CELLULAR_AT_SUCCESS )
+            if( atCoreStatus == CELLULAR_AT_SUCCESS )
+            {
+                if( ( tempValue >= INT16_MIN ) && ( tempValue <= INT16_MAX ) )
+                {
+                    pTemperatures->temperature3Celsius = ( int16_t ) tempValue;
+                }
+                else
+                {
+                    atCoreStatus = CELLULAR_AT_ERROR;
+                }
+            }
+
+            if( atCoreStatus != CELLULAR_AT_SUCCESS )
+            {
+                LogError( ( "_parseBoardTemperatures: Error in processing PA temperature. Token %s", pToken ) );
+                parseStatus = false;
+                pTemperatures->temperature3Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
+            }
+        }
+        else
+        {
+            LogError( ( "_parseBoardTemperatures: Error, missing PA temperature" ) );
+            parseStatus = false;
+        }
+    }
+
+    return parseStatus;
+}
+
+/* FreeRTOS Cellular Library types. */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+static CellularPktStatus_t _Cellular_RecvFuncGetTemperatures( CellularContext_t * pContext,
+                                                              const CellularATCommandResponse_t * pAtResp,
+                                                              void * pData,
+                                                              uint16_t dataLen )
+{
+    char * pInputLine = NULL;
+    CellularTemperatures_t * pTemperatures = ( CellularTemperatures_t * ) pData;
+    bool parseStatus = true;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+
+    if( pContext == NULL )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+    }
+    else if( ( pTemperatures == NULL ) || ( dataLen != sizeof( CellularTemperatures_t ) ) )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else if( ( pAtResp == NULL ) || ( pAtResp->pItm == NULL ) || ( pAtResp->pItm->pLine == NULL ) )
+    {
+        LogError( ( "_GetBoardTemperatures: Input Line passed is NULL" ) );
+        pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+    }
+    else
+    {
+        pInputLine = pAtResp->pItm->pLine;
+        atCoreStatus = Cellular_ATRemovePrefix( &pInputLine );
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pInputLine );
+        }
+
+        if( atCoreStatus != CELLULAR_AT_SUCCESS )
+        {
+            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+        }
+    }
+
+    if( pktStatus == CELLULAR_PKT_STATUS_OK )
+    {
+        parseStatus = _parseBoardTemperatures( pInputLine, pTemperatures );
+        if( parseStatus != true )
+        {
+            pTemperatures->temperature1Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
+            pTemperatures->temperature2Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
+            pTemperatures->temperature3Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
+            pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+        }
+    }
+
+    return pktStatus;
+}
+
+CellularError_t Cellular_GetModemTemperatures( CellularHandle_t cellularHandle,
+                                               CellularTemperatures_t * pTemperatures )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+
+    CellularAtReq_t atReqGetTemperatures =
+    {
+        "AT+QTEMP",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QTEMP",
+        _Cellular_RecvFuncGetTemperatures,
+        pTemperatures,
+        sizeof( CellularTemperatures_t ),
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pTemperatures == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqGetTemperatures,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "_GetBoardTemperatures: couldn't retrieve board temperatures" ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _adaptiveChunkNoteSignal( const CellularContext_t * pContext,
+                                      const CellularSignalInfo_t * pSignalInfo )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( ( pSignalInfo->rsrp != CELLULAR_INVALID_SIGNAL_VALUE ) &&
+        ( pSignalInfo->sinr != CELLULAR_INVALID_SIGNAL_VALUE ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->adaptiveChunkMutex );
+        pModuleContext->linkSignalKnown = true;
+        pModuleContext->linkSignalTicks = _Cellular_GetTicks();
+        pModuleContext->adaptiveChunkStats.rsrp = pSignalInfo->rsrp;
+        pModuleContext->adaptiveChunkStats.sinr = pSignalInfo->sinr;
+        PlatformMutex_Unlock( &pModuleContext->adaptiveChunkMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Below about 0 dB SINR or -115 dBm RSRP a full chunk rarely makes it within the send timeout. */
+static uint32_t _getSignalChunkCap( int16_t rsrp,
+                                    int16_t sinr )
+{
+    uint32_t chunkCap = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+
+    if( ( sinr < 0 ) || ( rsrp < -115 ) )
+    {
+        chunkCap = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN / 4U;
+    }
+    else if( ( sinr < 5 ) || ( rsrp < -105 ) )
+    {
+        chunkCap = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN / 2U;
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
+
+    if( chunkCap < CELLULAR_BG770_ADAPTIVE_CHUNK_MIN_SIZE )
+    {
+        chunkCap = CELLULAR_BG770_ADAPTIVE_CHUNK_MIN_SIZE;
+    }
+
+    return chunkCap;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t _getAdaptiveChunkSize( CellularContext_t * pContext,
+                                       uint32_t dataLength )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularAdaptiveChunkStats_t * pStats = NULL;
+    uint32_t sendLength = dataLength;
+    uint32_t chunkSize = 0;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->adaptiveChunkMutex );
+        pStats = &pModuleContext->adaptiveChunkStats;
+
+        if( pStats->enabled )
+        {
+            if( ( pModuleContext->linkSignalKnown ) &&
+                ( ( _Cellular_GetTicks() - pModuleContext->linkSignalTicks ) <
+                  pdMS_TO_TICKS( CELLULAR_BG770_ADAPTIVE_CHUNK_SIGNAL_MAX_AGE_MS ) ) )
+            {
+                pStats->signalCapSize = _getSignalChunkCap( pStats->rsrp, pStats->sinr );
+            }
+            else
+            {
+                pStats->signalCapSize = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+            }
+
+            chunkSize = ( pStats->chunkSize < pStats->signalCapSize ) ? pStats->chunkSize : pStats->signalCapSize;
+
+            if( sendLength > chunkSize )
+            {
+                sendLength = chunkSize;
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->adaptiveChunkMutex );
+    }
+
+    return sendLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Additive increase only when the chunk size was what limited the send, multiplicative decrease on a slow
+ * or failed one. */
+static void _adaptiveChunkFeedback( CellularContext_t * pContext,
+                                    uint32_t chunkLength,
+                                    uint32_t sentLength,
+                                    bool sendSucceeded,
+                                    uint32_t elapsedMs )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularAdaptiveChunkStats_t * pStats = NULL;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->adaptiveChunkMutex );
+        pStats = &pModuleContext->adaptiveChunkStats;
+
+        if( pStats->enabled )
+        {
+            pStats->sendCount++;
+            pStats->sendTimeTotalMs += elapsedMs;
+
+            if( sendSucceeded )
+            {
+                pStats->bytesSent += sentLength;
+            }
+            else
+            {
+                pStats->failedSendCount++;
+            }
+
+            if( pStats->sendTimeTotalMs > 0U )
             {
-                if( ( tempValue >= INT16_MIN ) && ( tempValue <= INT16_MAX ) )
+                pStats->goodputBytesPerSecond = ( uint32_t ) ( ( ( uint64_t ) pStats->bytesSent * 1000U ) /
+                                                               pStats->sendTimeTotalMs );
+            }
+
+            if( ( sendSucceeded == false ) || ( elapsedMs > CELLULAR_BG770_ADAPTIVE_CHUNK_SLOW_SEND_MS ) )
+            {
+                pStats->chunkSize = pStats->chunkSize / 2U;
+
+                if( pStats->chunkSize < CELLULAR_BG770_ADAPTIVE_CHUNK_MIN_SIZE )
                 {
-                    pTemperatures->temperature3Celsius = ( int16_t ) tempValue;
+                    pStats->chunkSize = CELLULAR_BG770_ADAPTIVE_CHUNK_MIN_SIZE;
                 }
-                else
+
+                pStats->decreaseCount++;
+                LogDebug( ( "_adaptiveChunkFeedback: %lu ms, chunk size %lu", elapsedMs, pStats->chunkSize ) );
+            }
+            else if( ( chunkLength >= pStats->chunkSize ) && ( sentLength == chunkLength ) &&
+                     ( pStats->chunkSize < ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN ) )
+            {
+                pStats->chunkSize += CELLULAR_BG770_ADAPTIVE_CHUNK_INCREASE;
+
+                if( pStats->chunkSize > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN )
                 {
-                    atCoreStatus = CELLULAR_AT_ERROR;
+                    pStats->chunkSize = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
                 }
-            }
 
-            if( atCoreStatus != CELLULAR_AT_SUCCESS )
+                pStats->increaseCount++;
+            }
+            else
             {
-                LogError( ( "_parseBoardTemperatures: Error in processing PA temperature. Token %s", pToken ) );
-                parseStatus = false;
-                pTemperatures->temperature3Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
+                /* Empty else MISRA 15.7 */
             }
         }
-        else
+
+        PlatformMutex_Unlock( &pModuleContext->adaptiveChunkMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetAdaptiveChunking( CellularHandle_t cellularHandle,
+                                              bool enable )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularAdaptiveChunkStats_t * pStats = NULL;
+    int16_t rsrp = CELLULAR_INVALID_SIGNAL_VALUE;
+    int16_t sinr = CELLULAR_INVALID_SIGNAL_VALUE;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->adaptiveChunkMutex );
+        pStats = &pModuleContext->adaptiveChunkStats;
+
+        if( ( enable ) && ( pStats->enabled == false ) )
         {
-            LogError( ( "_parseBoardTemperatures: Error, missing PA temperature" ) );
-            parseStatus = false;
+            /* Keep the last signal reading, it is still the best estimate of the link. */
+            rsrp = pStats->rsrp;
+            sinr = pStats->sinr;
+            ( void ) memset( pStats, 0, sizeof( CellularAdaptiveChunkStats_t ) );
+            pStats->rsrp = rsrp;
+            pStats->sinr = sinr;
+            pStats->chunkSize = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+            pStats->signalCapSize = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
         }
+
+        pStats->enabled = enable;
+        PlatformMutex_Unlock( &pModuleContext->adaptiveChunkMutex );
     }
 
-    return parseStatus;
+    return cellularStatus;
 }
 
-/* FreeRTOS Cellular Library types. */
-/* coverity[misra_c_2012_rule_8_13_violation] */
-static CellularPktStatus_t _Cellular_RecvFuncGetTemperatures( CellularContext_t * pContext,
-                                                              const CellularATCommandResponse_t * pAtResp,
-                                                              void * pData,
-                                                              uint16_t dataLen )
+/*-----------------------------------------------------------*/
+
+static int16_t _getHottestTemperature( const CellularTemperatures_t * pTemperatures )
 {
-    char * pInputLine = NULL;
-    CellularTemperatures_t * pTemperatures = ( CellularTemperatures_t * ) pData;
-    bool parseStatus = true;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    int16_t hottest = CELLULAR_INVALID_SIGNAL_VALUE;
+    const int16_t readings[ 3 ] =
+    {
+        pTemperatures->temperature1Celsius,
+        pTemperatures->temperature2Celsius,
+        pTemperatures->temperature3Celsius
+    };
+    uint8_t i = 0;
 
-    if( pContext == NULL )
+    for( i = 0; i < 3U; i++ )
     {
-        pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+        if( ( readings[ i ] != CELLULAR_INVALID_SIGNAL_VALUE ) &&
+            ( ( hottest == CELLULAR_INVALID_SIGNAL_VALUE ) || ( readings[ i ] > hottest ) ) )
+        {
+            hottest = readings[ i ];
+        }
     }
-    else if( ( pTemperatures == NULL ) || ( dataLen != sizeof( CellularTemperatures_t ) ) )
+
+    return hottest;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Samples only while a transfer is already running, a single send does not heat the modem. A step is
+ * entered at its threshold and left hysteresisCelsius below it. Returns the length to send. */
+static uint32_t _applyThermalGovernor( CellularContext_t * pContext,
+                                       uint32_t dataLength,
+                                       const TickType_t * pDeadlineTicks )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularTemperatures_t temperatures = { 0 };
+    CellularAtReq_t atReqGetTemperatures =
     {
-        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+        "AT+QTEMP",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QTEMP",
+        _Cellular_RecvFuncGetTemperatures,
+        &temperatures,
+        sizeof( CellularTemperatures_t ),
+    };
+    CellularThermalStepCallback_t stepCallback = NULL;
+    void * pStepCallbackContext = NULL;
+    uint32_t sendLength = dataLength;
+    uint32_t delayMs = 0;
+    bool enabled = false;
+    bool sampleDue = false;
+    bool stepChanged = false;
+    int16_t temperatureCelsius = CELLULAR_INVALID_SIGNAL_VALUE;
+    uint8_t step = 0;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->thermalMutex );
+        enabled = pModuleContext->thermalGovernorEnabled;
+        sampleDue = ( pModuleContext->thermalSampled == false ) ||
+                    ( ( _Cellular_GetTicks() - pModuleContext->thermalSampleTicks ) >=
+                      pdMS_TO_TICKS( pModuleContext->thermalConfig.sampleIntervalMs ) );
+        PlatformMutex_Unlock( &pModuleContext->thermalMutex );
     }
-    else if( ( pAtResp == NULL ) || ( pAtResp->pItm == NULL ) || ( pAtResp->pItm->pLine == NULL ) )
+
+    /* Sampled in the data class within the send deadline, in the background class it would wait behind
+     * the very transfer it is meant to throttle. */
+    if( ( enabled ) && ( sampleDue ) && ( _Cellular_IsDataTransferActive( pModuleContext ) ) &&
+        ( _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_DATA, atReqGetTemperatures,
+                                                    PACKET_REQ_TIMEOUT_MS, pDeadlineTicks ) == CELLULAR_PKT_STATUS_OK ) )
     {
-        LogError( ( "_GetBoardTemperatures: Input Line passed is NULL" ) );
-        pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+        temperatureCelsius = _getHottestTemperature( &temperatures );
     }
-    else
+
+    if( enabled )
     {
-        pInputLine = pAtResp->pItm->pLine;
-        atCoreStatus = Cellular_ATRemovePrefix( &pInputLine );
+        PlatformMutex_Lock( &pModuleContext->thermalMutex );
+        step = pModuleContext->thermalStats.step;
 
-        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        if( temperatureCelsius != CELLULAR_INVALID_SIGNAL_VALUE )
         {
-            atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pInputLine );
+            pModuleContext->thermalSampled = true;
+            pModuleContext->thermalSampleTicks = _Cellular_GetTicks();
+            pModuleContext->thermalStats.sampleCount++;
+            pModuleContext->thermalStats.lastTemperatureCelsius = temperatureCelsius;
+
+            while( ( step < CELLULAR_BG770_THERMAL_STEP_COUNT ) &&
+                   ( temperatureCelsius >= pModuleContext->thermalConfig.thresholdCelsius[ step ] ) )
+            {
+                step++;
+            }
+
+            while( ( step > 0U ) &&
+                   ( temperatureCelsius < ( pModuleContext->thermalConfig.thresholdCelsius[ step - 1U ] -
+                                            pModuleContext->thermalConfig.hysteresisCelsius ) ) )
+            {
+                step--;
+            }
+
+            if( step != pModuleContext->thermalStats.step )
+            {
+                pModuleContext->thermalStats.step = step;
+                pModuleContext->thermalStats.stepChangeCount++;
+                stepChanged = true;
+                stepCallback = pModuleContext->thermalStepCallback;
+                pStepCallbackContext = pModuleContext->pThermalStepCallbackContext;
+            }
         }
 
-        if( atCoreStatus != CELLULAR_AT_SUCCESS )
+        if( step > 0U )
         {
-            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+            if( sendLength > pModuleContext->thermalConfig.maxChunkSize[ step - 1U ] )
+            {
+                sendLength = pModuleContext->thermalConfig.maxChunkSize[ step - 1U ];
+            }
+
+            delayMs = pModuleContext->thermalConfig.interSendDelayMs[ step - 1U ];
+            pModuleContext->thermalStats.throttledSendCount++;
+            pModuleContext->thermalStats.delayedTotalMs += delayMs;
         }
+
+        PlatformMutex_Unlock( &pModuleContext->thermalMutex );
     }
 
-    if( pktStatus == CELLULAR_PKT_STATUS_OK )
+    if( stepChanged )
     {
-        parseStatus = _parseBoardTemperatures( pInputLine, pTemperatures );
-        if( parseStatus != true )
+        LogInfo( ( "_applyThermalGovernor: %d C, throttle step %u", temperatureCelsius, step ) );
+
+        if( stepCallback != NULL )
         {
-            pTemperatures->temperature1Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
-            pTemperatures->temperature2Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
-            pTemperatures->temperature3Celsius = CELLULAR_INVALID_SIGNAL_VALUE;
-            pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+            stepCallback( step, temperatureCelsius, pStepCallbackContext );
         }
     }
 
-    return pktStatus;
+    if( delayMs > 0U )
+    {
+        _Cellular_DelayTicks( pdMS_TO_TICKS( delayMs ) );
+    }
+
+    return sendLength;
 }
 
-CellularError_t Cellular_GetModemTemperatures( CellularHandle_t cellularHandle,
-                                               CellularTemperatures_t * pTemperatures )
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetThermalGovernor( CellularHandle_t cellularHandle,
+                                             const CellularThermalGovernorConfig_t * pConfig,
+                                             CellularThermalStepCallback_t stepCallback,
+                                             void * pCallbackContext )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-
-    CellularAtReq_t atReqGetTemperatures =
-    {
-        "AT+QTEMP",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QTEMP",
-        _Cellular_RecvFuncGetTemperatures,
-        pTemperatures,
-        sizeof( CellularTemperatures_t ),
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint8_t i = 0;
 
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
-    if( cellularStatus != CELLULAR_SUCCESS )
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pConfig != NULL ) )
     {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+        if( pConfig->hysteresisCelsius < 0 )
+        {
+            cellularStatus = CELLULAR_BAD_PARAMETER;
+        }
+
+        for( i = 0; ( i < CELLULAR_BG770_THERMAL_STEP_COUNT ) && ( cellularStatus == CELLULAR_SUCCESS ); i++ )
+        {
+            if( ( pConfig->maxChunkSize[ i ] == 0U ) ||
+                ( ( i > 0U ) && ( pConfig->thresholdCelsius[ i ] <= pConfig->thresholdCelsius[ i - 1U ] ) ) )
+            {
+                LogError( ( "Cellular_SetThermalGovernor: Invalid step %u", i ) );
+                cellularStatus = CELLULAR_BAD_PARAMETER;
+            }
+        }
     }
-    else if( pTemperatures == NULL )
+
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
-    else
+
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqGetTemperatures );
+        PlatformMutex_Lock( &pModuleContext->thermalMutex );
+        pModuleContext->thermalGovernorEnabled = ( pConfig != NULL );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( pConfig != NULL )
         {
-            LogError( ( "_GetBoardTemperatures: couldn't retrieve board temperatures" ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            pModuleContext->thermalConfig = *pConfig;
         }
+
+        pModuleContext->thermalStepCallback = stepCallback;
+        pModuleContext->pThermalStepCallbackContext = pCallbackContext;
+        pModuleContext->thermalSampled = false;
+        pModuleContext->thermalStats.step = 0;
+        PlatformMutex_Unlock( &pModuleContext->thermalMutex );
     }
 
     return cellularStatus;
@@ -8022,8 +10859,10 @@ static CellularPktStatus_t _Cellular_RecvFuncGetNetworkInfo( CellularContext_t *
     return pktStatus;
 }
 
+/* The AT+CEREG? response starts with <n>, the URC does not. */
 static bool _Cellular_ParseLTENetworkInfoPsRegStatus( char * pCeregPayload,
-                                                      CellularLTENetworkInfo_t * pLTENetworkInfo )
+                                                      CellularLTENetworkInfo_t * pLTENetworkInfo,
+                                                      bool hasUrcSetting )
 {
     char * pToken = NULL, * pTmpCeregPayload = pCeregPayload;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
@@ -8039,7 +10878,7 @@ static bool _Cellular_ParseLTENetworkInfoPsRegStatus( char * pCeregPayload,
         parseStatus = false;
     }
 
-    if( parseStatus == true )
+    if( ( parseStatus == true ) && ( hasUrcSetting == true ) )
     {
         /* NOTE: Don't care about value, but must be present. */
         if( Cellular_ATGetNextTok( &pTmpCeregPayload, &pToken ) != CELLULAR_AT_SUCCESS )
@@ -8232,7 +11071,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetNetworkPsRegStatus( CellularCont
 
     if( pktStatus == CELLULAR_PKT_STATUS_OK )
     {
-        parseStatus = _Cellular_ParseLTENetworkInfoPsRegStatus( pInputLine, pLTENetworkInfo );
+        parseStatus = _Cellular_ParseLTENetworkInfoPsRegStatus( pInputLine, pLTENetworkInfo, true );
         if( parseStatus != true )
         {
             pLTENetworkInfo->trackingAreaCode = CELLULAR_INVALID_TRACKING_AREA_CODE;
@@ -8249,6 +11088,7 @@ CellularError_t Cellular_GetLTENetworkInfo( CellularHandle_t cellularHandle,
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
 
     CellularAtReq_t atReqGetNetworkInfo =
     {
@@ -8282,7 +11122,8 @@ CellularError_t Cellular_GetLTENetworkInfo( CellularHandle_t cellularHandle,
     }
     else
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqGetNetworkInfo );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqGetNetworkInfo,
+                                                              PACKET_REQ_TIMEOUT_MS, NULL );
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
@@ -8293,7 +11134,8 @@ CellularError_t Cellular_GetLTENetworkInfo( CellularHandle_t cellularHandle,
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqGetNetworkRegistrationStatus );
+        pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND,
+                                                              atReqGetNetworkRegistrationStatus, PACKET_REQ_TIMEOUT_MS, NULL );
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
@@ -8305,6 +11147,168 @@ CellularError_t Cellular_GetLTENetworkInfo( CellularHandle_t cellularHandle,
         pLTENetworkInfo->trackingAreaCode = CELLULAR_INVALID_TRACKING_AREA_CODE;
     }
 
+    if( ( cellularStatus == CELLULAR_SUCCESS ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->servingCellMutex );
+        pModuleContext->servingCell = *pLTENetworkInfo;
+        pModuleContext->servingCellKnown = true;
+        pModuleContext->servingCellInfoValid = true;
+        pModuleContext->servingCellUpdatedTicks = _Cellular_GetTicks();
+        PlatformMutex_Unlock( &pModuleContext->servingCellMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called from the CEREG URC handler with a copy of the URC payload. */
+void _Cellular_ServingCellUpdateFromCereg( const CellularContext_t * pContext,
+                                           char * pCeregPayload )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularLTENetworkInfo_t ceregInfo = { 0 };
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+
+    atCoreStatus = Cellular_ATRemoveAllDoubleQuote( pCeregPayload );
+
+    if( atCoreStatus == CELLULAR_AT_SUCCESS )
+    {
+        atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pCeregPayload );
+    }
+
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) &&
+        ( _Cellular_ParseLTENetworkInfoPsRegStatus( pCeregPayload, &ceregInfo, false ) == true ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->servingCellMutex );
+
+        if( ( pModuleContext->servingCellKnown == false ) ||
+            ( pModuleContext->servingCell.trackingAreaCode != ceregInfo.trackingAreaCode ) ||
+            ( pModuleContext->servingCell.cellId != ceregInfo.cellId ) )
+        {
+            LogDebug( ( "_Cellular_ServingCellUpdateFromCereg: cell %lx tac %x",
+                        ceregInfo.cellId, ceregInfo.trackingAreaCode ) );
+            pModuleContext->servingCell.trackingAreaCode = ceregInfo.trackingAreaCode;
+            pModuleContext->servingCell.cellId = ceregInfo.cellId;
+            pModuleContext->servingCellInfoValid = false;
+            pModuleContext->servingCellChangeCount++;
+        }
+
+        pModuleContext->servingCellKnown = true;
+        pModuleContext->servingCellUpdatedTicks = _Cellular_GetTicks();
+        PlatformMutex_Unlock( &pModuleContext->servingCellMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetCachedLTENetworkInfo( CellularHandle_t cellularHandle,
+                                                  CellularLTENetworkInfo_t * pLTENetworkInfo,
+                                                  uint32_t * pAgeMs )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularLTENetworkInfo_t networkInfo = { 0 };
+    bool servingCellKnown = false;
+    bool servingCellInfoValid = false;
+    uint32_t servingCellChangeCount = 0;
+    TickType_t updatedTicks = 0;
+
+    CellularAtReq_t atReqGetNetworkInfo =
+    {
+        "AT+QNWINFO",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QNWINFO",
+        _Cellular_RecvFuncGetNetworkInfo,
+        &networkInfo,
+        sizeof( CellularLTENetworkInfo_t ),
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pLTENetworkInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->servingCellMutex );
+        *pLTENetworkInfo = pModuleContext->servingCell;
+        servingCellKnown = pModuleContext->servingCellKnown;
+        servingCellInfoValid = pModuleContext->servingCellInfoValid;
+        servingCellChangeCount = pModuleContext->servingCellChangeCount;
+        PlatformMutex_Unlock( &pModuleContext->servingCellMutex );
+
+        if( servingCellKnown == false )
+        {
+            /* Nothing reported yet, read everything. It fills the cache on success. */
+            cellularStatus = Cellular_GetLTENetworkInfo( cellularHandle, pLTENetworkInfo );
+        }
+        else if( servingCellInfoValid == false )
+        {
+            /* The URC moved the cell, only the AT+QNWINFO fields need reading. */
+            pktStatus = _priorityTimeoutAtcmdRequestWithCallback( pContext, CELLULAR_AT_PRIORITY_BACKGROUND, atReqGetNetworkInfo,
+                                                                  PACKET_REQ_TIMEOUT_MS, NULL );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Lock( &pModuleContext->servingCellMutex );
+
+                /* A further cell change during the read makes it stale, report it but keep the cache invalid. */
+                if( servingCellChangeCount == pModuleContext->servingCellChangeCount )
+                {
+                    pModuleContext->servingCell.plmnInfo = networkInfo.plmnInfo;
+                    pModuleContext->servingCell.lteBand = networkInfo.lteBand;
+                    pModuleContext->servingCell.lteChannelId = networkInfo.lteChannelId;
+                    pModuleContext->servingCellInfoValid = true;
+                    pModuleContext->servingCellUpdatedTicks = _Cellular_GetTicks();
+                }
+
+                PlatformMutex_Unlock( &pModuleContext->servingCellMutex );
+
+                pLTENetworkInfo->plmnInfo = networkInfo.plmnInfo;
+                pLTENetworkInfo->lteBand = networkInfo.lteBand;
+                pLTENetworkInfo->lteChannelId = networkInfo.lteChannelId;
+            }
+            else
+            {
+                LogError( ( "Cellular_GetCachedLTENetworkInfo: couldn't retrieve network info" ) );
+            }
+        }
+        else
+        {
+            /* Served from the cache. */
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->servingCellMutex );
+        updatedTicks = pModuleContext->servingCellUpdatedTicks;
+        PlatformMutex_Unlock( &pModuleContext->servingCellMutex );
+
+        if( pAgeMs != NULL )
+        {
+            *pAgeMs = ( uint32_t ) ( ( ( uint64_t ) ( _Cellular_GetTicks() - updatedTicks ) * 1000U ) /
+                                     ( uint64_t ) configTICK_RATE_HZ );
+        }
+    }
+
     return cellularStatus;
 }
 
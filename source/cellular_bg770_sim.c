@@ -0,0 +1,1108 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+/* The config header is always included first. */
+#include "cellular_config.h"
+#include "cellular_config_defaults.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cellular_platform.h"
+#include "cellular_bg770_sim.h"
+
+/*-----------------------------------------------------------*/
+
+#define SIM_EVT_MASK_STOP         ( 0x0001UL )
+#define SIM_EVT_MASK_STOPPED      ( 0x0002UL )
+#define SIM_EVT_MASK_RX_READY     ( 0x0004UL )
+
+#define SIM_STOP_TIMEOUT_ticks    ( pdMS_TO_TICKS( 1000U ) )
+
+#define SIM_OUTPUT_BUFFER_SIZE    ( CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH * 2U )
+
+/* defaultLatencyMs, bootDelayMs, throughputBytesPerSecond, connectLatencyMs, dnsLatencyMs, pRules, ruleCount,
+ * simulatedClock. */
+#define SIM_DEFAULT_CONFIG        { 10U, 100U, 0U, 50U, 100U, NULL, 0U, false }
+
+/*-----------------------------------------------------------*/
+
+typedef struct simPendingOutput
+{
+    bool inUse;
+    bool isUrc;
+    uint32_t sequence; /* Queue order, breaks ties between equal due times. */
+    TickType_t dueTicks;
+    uint16_t length;
+    uint8_t data[ CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH ];
+} simPendingOutput_t;
+
+typedef struct simSocket
+{
+    uint32_t rxLength;
+    uint32_t totalRead;
+    uint8_t rxData[ CELLULAR_BG770_SIM_SOCKET_BUFFER_SIZE ];
+} simSocket_t;
+
+typedef struct simClockWaiter
+{
+    bool inUse;
+    TickType_t wakeTicks;
+} simClockWaiter_t;
+
+typedef enum simInputState
+{
+    SIM_INPUT_COMMAND,
+    SIM_INPUT_SEND_DATA
+} simInputState_t;
+
+typedef struct simContext
+{
+    PlatformMutex_t simMutex;
+    PlatformEventGroupHandle_t pSimEvent;
+    bool opened;
+    CellularCommInterfaceReceiveCallback_t receiveCallback;
+    void * pUserData;
+
+    /* Responses and URCs not yet due, sent earliest due first. */
+    simPendingOutput_t pending[ CELLULAR_BG770_SIM_PENDING_OUTPUT_COUNT ];
+    uint8_t pendingCount;
+    uint32_t nextSequence;
+    TickType_t lastResponseDueTicks;
+
+    /* Bytes the port has not read yet. */
+    uint8_t output[ SIM_OUTPUT_BUFFER_SIZE ];
+    uint32_t outputHead;
+    uint32_t outputCount;
+
+    /* Command line or AT+QISEND payload being received. */
+    simInputState_t inputState;
+    char command[ CELLULAR_BG770_SIM_MAX_COMMAND_LENGTH ];
+    uint16_t commandLength;
+    bool commandOverflow;
+    uint32_t sendRemaining;
+    uint32_t sendLength;
+
+    /* Host names resolved so far, each gets its own address. */
+    uint32_t dnsQueryCount;
+
+    simSocket_t sockets[ CELLULAR_BG770_SIM_SOCKET_COUNT ];
+    CellularBg770SimStats_t stats;
+} simContext_t;
+
+/*-----------------------------------------------------------*/
+
+static CellularCommInterfaceError_t _simOpen( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                              void * pUserData,
+                                              CellularCommInterfaceHandle_t * pCommInterfaceHandle );
+static CellularCommInterfaceError_t _simSend( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                              const uint8_t * pData,
+                                              uint32_t dataLength,
+                                              uint32_t timeoutMilliseconds,
+                                              uint32_t * pDataSentLength );
+static CellularCommInterfaceError_t _simRecv( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                              uint8_t * pBuffer,
+                                              uint32_t bufferLength,
+                                              uint32_t timeoutMilliseconds,
+                                              uint32_t * pDataReceivedLength );
+static CellularCommInterfaceError_t _simClose( CellularCommInterfaceHandle_t commInterfaceHandle );
+static TickType_t _simClockGetTicks( void );
+static void _simClockDelayTicks( TickType_t ticks );
+static void _simClockAdvanceTo( TickType_t targetTicks );
+static void _simClockSetOutputBound( const simPendingOutput_t * pNextOutput );
+static TickType_t _simNow( void );
+static uint32_t _simTransferMs( uint32_t length );
+static bool _simQueueOutput( const uint8_t * pData,
+                             uint32_t length,
+                             uint32_t delayMs,
+                             bool isUrc );
+static bool _simQueueLines( const char * pText,
+                            uint32_t delayMs,
+                            bool isUrc );
+static simPendingOutput_t * _simNextOutput( void );
+static bool _simParseNumbers( const char * pParams,
+                              uint32_t * pValues,
+                              uint8_t valueCount );
+static void _simHandleOpen( const char * pParams,
+                            bool isSsl );
+static void _simHandleSend( const char * pParams );
+static void _simHandleSendComplete( void );
+static void _simHandleRead( const char * pParams,
+                            bool isSsl );
+static void _simHandleClose( const char * pParams );
+static void _simHandleDns( void );
+static void _simHandleCommand( void );
+static void _simThread( void * pArgument );
+
+/*-----------------------------------------------------------*/
+
+/* Answers used when no rule matches, enough for Cellular_Init() and registration. Anything else gets OK. */
+static const CellularBg770SimRule_t _simDefaultRules[] =
+{
+    { "AT+CPIN?",   "+CPIN: READY\r\nOK",                           0U },
+    { "AT+CEREG?",  "+CEREG: 2,1\r\nOK",                            0U },
+    { "AT+CGREG?",  "+CGREG: 2,1\r\nOK",                            0U },
+    { "AT+COPS?",   "+COPS: 0,2,\"310410\",8\r\nOK",                0U },
+    { "AT+QCSQ",    "+QCSQ: \"eMTC\",-65,-90,150,-9\r\nOK",         0U },
+    { "AT+CSQ",     "+CSQ: 20,99\r\nOK",                            0U },
+    { "AT+QTEMP",   "+QTEMP: 30,31,32\r\nOK",                       0U },
+    { "AT+CGMI",    "Quectel\r\nOK",                                0U },
+    { "AT+CGMM",    "BG770A-GL\r\nOK",                              0U },
+    { "AT+CGMR",    "BG770AGLAAR02A04\r\nOK",                       0U },
+    { "AT+CGSN",    "860000000000000\r\nOK",                        0U },
+    { "AT+QCCID",   "+QCCID: 89010000000000000000\r\nOK",           0U },
+    { "AT+CIMI",    "310410000000000\r\nOK",                        0U },
+    { "AT+CCLK?",   "+CCLK: \"26/01/01,00:00:00+00\"\r\nOK",        0U },
+    { "AT+CGPADDR", "+CGPADDR: 1,\"10.0.0.2\"\r\nOK",               0U },
+};
+
+static const CellularBg770SimConfig_t _simDefaultConfig = SIM_DEFAULT_CONFIG;
+
+static CellularBg770SimConfig_t simConfig = SIM_DEFAULT_CONFIG;
+
+static simContext_t simContext;
+
+static TickType_t simClockTicks = 0;
+
+/* Tasks blocked in _simClockDelayTicks(), protected by a critical section like simClockTicks. */
+static simClockWaiter_t simClockWaiters[ CELLULAR_BG770_SIM_CLOCK_WAITER_COUNT ];
+
+/* Due time of the next emulator output with simulatedClock set, the clock waits there until it is sent. */
+static bool simClockOutputPending = false;
+static TickType_t simClockOutputDueTicks = 0;
+
+CellularCommInterface_t CellularBg770SimCommInterface =
+{
+    .open  = _simOpen,
+    .send  = _simSend,
+    .recv  = _simRecv,
+    .close = _simClose
+};
+
+const CellularBg770Clock_t CellularBg770SimClock =
+{
+    .getTicks   = _simClockGetTicks,
+    .delayTicks = _simClockDelayTicks
+};
+
+/*-----------------------------------------------------------*/
+
+static TickType_t _simClockGetTicks( void )
+{
+    TickType_t ticks = 0;
+
+    taskENTER_CRITICAL();
+    ticks = simClockTicks;
+    taskEXIT_CRITICAL();
+
+    return ticks;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The clock only moves to the earliest wake time, so delayed tasks wake in the order of their wake times
+ * whichever runs first. A task still in the earlier wait is given real ticks to run before the clock moves on.
+ * Every delay blocks for at least one real tick first, as a real delay would, so a task polling on the clock
+ * lets the others, such as the reader of an output just sent, run before time moves. */
+static void _simClockDelayTicks( TickType_t ticks )
+{
+    simClockWaiter_t * pWaiter = NULL;
+    TickType_t wakeTicks = 0;
+    bool woken = false;
+    uint8_t i = 0;
+
+    if( ticks == 0U )
+    {
+        /* A zero delay still lets the other tasks run, as a real delay would. */
+        vTaskDelay( 0U );
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+        wakeTicks = simClockTicks + ticks;
+
+        for( i = 0; ( i < CELLULAR_BG770_SIM_CLOCK_WAITER_COUNT ) && ( pWaiter == NULL ); i++ )
+        {
+            if( simClockWaiters[ i ].inUse == false )
+            {
+                pWaiter = &simClockWaiters[ i ];
+                pWaiter->inUse = true;
+                pWaiter->wakeTicks = wakeTicks;
+            }
+        }
+
+        taskEXIT_CRITICAL();
+
+        /* Without a free slot the task is not seen by the others, it still never moves the clock past them. */
+        while( woken == false )
+        {
+            vTaskDelay( 1U );
+
+            taskENTER_CRITICAL();
+            _simClockAdvanceTo( wakeTicks );
+            woken = ( ( int32_t ) ( simClockTicks - wakeTicks ) >= 0 );
+
+            if( ( woken ) && ( pWaiter != NULL ) )
+            {
+                pWaiter->inUse = false;
+            }
+
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called in a critical section. Moves the clock to targetTicks, or to an earlier wake time of a delayed task
+ * or due time of the next emulator output. */
+static void _simClockAdvanceTo( TickType_t targetTicks )
+{
+    TickType_t nextTicks = targetTicks;
+    uint8_t i = 0;
+
+    if( ( simClockOutputPending ) && ( ( int32_t ) ( simClockOutputDueTicks - nextTicks ) < 0 ) )
+    {
+        nextTicks = simClockOutputDueTicks;
+    }
+
+    for( i = 0; i < CELLULAR_BG770_SIM_CLOCK_WAITER_COUNT; i++ )
+    {
+        if( ( simClockWaiters[ i ].inUse ) && ( ( int32_t ) ( simClockWaiters[ i ].wakeTicks - nextTicks ) < 0 ) )
+        {
+            nextTicks = simClockWaiters[ i ].wakeTicks;
+        }
+    }
+
+    if( ( int32_t ) ( nextTicks - simClockTicks ) > 0 )
+    {
+        simClockTicks = nextTicks;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with simMutex held whenever the next output changes, pNextOutput NULL when none is pending. */
+static void _simClockSetOutputBound( const simPendingOutput_t * pNextOutput )
+{
+    taskENTER_CRITICAL();
+    simClockOutputPending = ( ( simConfig.simulatedClock ) && ( pNextOutput != NULL ) );
+    simClockOutputDueTicks = ( pNextOutput != NULL ) ? pNextOutput->dueTicks : 0U;
+    taskEXIT_CRITICAL();
+}
+
+/*-----------------------------------------------------------*/
+
+static TickType_t _simNow( void )
+{
+    return simConfig.simulatedClock ? _simClockGetTicks() : xTaskGetTickCount();
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t _simTransferMs( uint32_t length )
+{
+    uint32_t transferMs = 0;
+
+    if( simConfig.throughputBytesPerSecond != 0U )
+    {
+        transferMs = ( uint32_t ) ( ( ( uint64_t ) length * 1000U ) / simConfig.throughputBytesPerSecond );
+    }
+
+    return transferMs;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with simMutex held. Responses leave in order, a short delay never overtakes an earlier long one.
+ * A URC is sent when its own delay expires, a slow response does not hold it back. */
+static bool _simQueueOutput( const uint8_t * pData,
+                             uint32_t length,
+                             uint32_t delayMs,
+                             bool isUrc )
+{
+    simPendingOutput_t * pOutput = NULL;
+    TickType_t dueTicks = _simNow() + pdMS_TO_TICKS( delayMs );
+    bool responsePending = false;
+    bool queued = false;
+    uint8_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG770_SIM_PENDING_OUTPUT_COUNT; i++ )
+    {
+        if( simContext.pending[ i ].inUse == false )
+        {
+            if( pOutput == NULL )
+            {
+                pOutput = &simContext.pending[ i ];
+            }
+        }
+        else if( simContext.pending[ i ].isUrc == false )
+        {
+            responsePending = true;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+    if( ( pOutput == NULL ) || ( length > CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH ) )
+    {
+        simContext.stats.droppedOutputCount++;
+    }
+    else
+    {
+        if( ( isUrc == false ) && ( responsePending ) &&
+            ( ( int32_t ) ( dueTicks - simContext.lastResponseDueTicks ) < 0 ) )
+        {
+            dueTicks = simContext.lastResponseDueTicks;
+        }
+
+        pOutput->inUse = true;
+        pOutput->isUrc = isUrc;
+        pOutput->sequence = simContext.nextSequence;
+        pOutput->dueTicks = dueTicks;
+        pOutput->length = ( uint16_t ) length;
+        ( void ) memcpy( pOutput->data, pData, length );
+        simContext.nextSequence++;
+        simContext.pendingCount++;
+
+        if( isUrc == false )
+        {
+            simContext.lastResponseDueTicks = dueTicks;
+        }
+
+        _simClockSetOutputBound( _simNextOutput() );
+        queued = true;
+    }
+
+    return queued;
+}
+
+/*-----------------------------------------------------------*/
+
+static bool _simQueueLines( const char * pText,
+                            uint32_t delayMs,
+                            bool isUrc )
+{
+    char lines[ CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH ] = { '\0' };
+    int length = 0;
+    bool queued = false;
+
+    length = snprintf( lines, sizeof( lines ), "\r\n%s\r\n", pText );
+
+    if( ( length > 0 ) && ( ( uint32_t ) length < sizeof( lines ) ) )
+    {
+        queued = _simQueueOutput( ( const uint8_t * ) lines, ( uint32_t ) length, delayMs, isUrc );
+    }
+    else
+    {
+        simContext.stats.droppedOutputCount++;
+    }
+
+    return queued;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with simMutex held. The earliest due output, the first queued of equal ones, NULL if none. */
+static simPendingOutput_t * _simNextOutput( void )
+{
+    simPendingOutput_t * pNext = NULL;
+    simPendingOutput_t * pOutput = NULL;
+    uint8_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG770_SIM_PENDING_OUTPUT_COUNT; i++ )
+    {
+        pOutput = &simContext.pending[ i ];
+
+        if( ( pOutput->inUse ) &&
+            ( ( pNext == NULL ) ||
+              ( ( int32_t ) ( pOutput->dueTicks - pNext->dueTicks ) < 0 ) ||
+              ( ( pOutput->dueTicks == pNext->dueTicks ) && ( ( int32_t ) ( pOutput->sequence - pNext->sequence ) < 0 ) ) ) )
+        {
+            pNext = pOutput;
+        }
+    }
+
+    return pNext;
+}
+
+/*-----------------------------------------------------------*/
+
+static bool _simParseNumbers( const char * pParams,
+                              uint32_t * pValues,
+                              uint8_t valueCount )
+{
+    const char * pCursor = pParams;
+    char * pEnd = NULL;
+    uint8_t i = 0;
+    bool parsed = true;
+
+    for( i = 0; ( i < valueCount ) && ( parsed ); i++ )
+    {
+        pValues[ i ] = ( uint32_t ) strtoul( pCursor, &pEnd, 10 );
+
+        if( pEnd == pCursor )
+        {
+            parsed = false;
+        }
+        else if( *pEnd == ',' )
+        {
+            pCursor = pEnd + 1;
+        }
+        else
+        {
+            /* Last parameter, further values fail on the next round. */
+            pCursor = pEnd;
+        }
+    }
+
+    return parsed;
+}
+
+/*-----------------------------------------------------------*/
+
+/* AT+QIOPEN=<contextID>,<connectID>,... or AT+QSSLOPEN=<pdpctxID>,<sslctxID>,<clientID>,... */
+static void _simHandleOpen( const char * pParams,
+                            bool isSsl )
+{
+    uint32_t values[ 3 ] = { 0 };
+    uint32_t socketId = 0;
+    char urc[ 32 ] = { '\0' };
+
+    if( ( _simParseNumbers( pParams, values, isSsl ? 3U : 2U ) == false ) ||
+        ( values[ isSsl ? 2 : 1 ] >= CELLULAR_BG770_SIM_SOCKET_COUNT ) )
+    {
+        ( void ) _simQueueLines( "ERROR", simConfig.defaultLatencyMs, false );
+    }
+    else
+    {
+        socketId = values[ isSsl ? 2 : 1 ];
+        simContext.sockets[ socketId ].rxLength = 0;
+        simContext.sockets[ socketId ].totalRead = 0;
+        ( void ) _simQueueLines( "OK", simConfig.defaultLatencyMs, false );
+        ( void ) snprintf( urc, sizeof( urc ), "%s: %u,0", isSsl ? "+QSSLOPEN" : "+QIOPEN", ( unsigned int ) socketId );
+        /* The modem answers OK before the connection result. */
+        ( void ) _simQueueLines( urc, ( simConfig.connectLatencyMs > simConfig.defaultLatencyMs ) ?
+                                 simConfig.connectLatencyMs : simConfig.defaultLatencyMs, true );
+        simContext.stats.urcCount++;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* AT+QISEND=<connectID>,<send_length>, the payload follows the prompt. AT+QSSLSEND is the same. */
+static void _simHandleSend( const char * pParams )
+{
+    uint32_t values[ 2 ] = { 0 };
+
+    if( ( _simParseNumbers( pParams, values, 2U ) == false ) ||
+        ( values[ 0 ] >= CELLULAR_BG770_SIM_SOCKET_COUNT ) || ( values[ 1 ] == 0U ) )
+    {
+        ( void ) _simQueueLines( "ERROR", simConfig.defaultLatencyMs, false );
+    }
+    else
+    {
+        simContext.inputState = SIM_INPUT_SEND_DATA;
+        simContext.sendRemaining = values[ 1 ];
+        simContext.sendLength = values[ 1 ];
+        ( void ) _simQueueOutput( ( const uint8_t * ) "> ", 2U, simConfig.defaultLatencyMs, false );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void _simHandleSendComplete( void )
+{
+    simContext.inputState = SIM_INPUT_COMMAND;
+    simContext.stats.socketBytesSent += simContext.sendLength;
+    ( void ) _simQueueLines( "SEND OK", simConfig.defaultLatencyMs + _simTransferMs( simContext.sendLength ), false );
+}
+
+/*-----------------------------------------------------------*/
+
+/* AT+QIRD=<connectID>,<read_length>, a zero length asks for the counters. */
+static void _simHandleRead( const char * pParams,
+                            bool isSsl )
+{
+    uint32_t values[ 2 ] = { 0 };
+    simSocket_t * pSocket = NULL;
+    const char * pPrefix = isSsl ? "+QSSLRECV" : "+QIRD";
+    char response[ CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH ] = { '\0' };
+    uint32_t readLength = 0;
+    int headerLength = 0;
+
+    if( ( _simParseNumbers( pParams, values, 2U ) == false ) ||
+        ( values[ 0 ] >= CELLULAR_BG770_SIM_SOCKET_COUNT ) )
+    {
+        ( void ) _simQueueLines( "ERROR", simConfig.defaultLatencyMs, false );
+    }
+    else if( values[ 1 ] == 0U )
+    {
+        pSocket = &simContext.sockets[ values[ 0 ] ];
+        ( void ) snprintf( response, sizeof( response ), "%s: %u,%u,%u\r\nOK", pPrefix,
+                           ( unsigned int ) ( pSocket->totalRead + pSocket->rxLength ),
+                           ( unsigned int ) pSocket->totalRead, ( unsigned int ) pSocket->rxLength );
+        ( void ) _simQueueLines( response, simConfig.defaultLatencyMs, false );
+    }
+    else
+    {
+        pSocket = &simContext.sockets[ values[ 0 ] ];
+        readLength = ( values[ 1 ] < pSocket->rxLength ) ? values[ 1 ] : pSocket->rxLength;
+        headerLength = snprintf( response, sizeof( response ), "\r\n%s: %u\r\n", pPrefix, ( unsigned int ) readLength );
+
+        if( ( uint32_t ) headerLength + readLength + 8U > sizeof( response ) )
+        {
+            readLength = ( uint32_t ) sizeof( response ) - ( uint32_t ) headerLength - 8U;
+            headerLength = snprintf( response, sizeof( response ), "\r\n%s: %u\r\n", pPrefix, ( unsigned int ) readLength );
+        }
+
+        ( void ) memcpy( &response[ headerLength ], pSocket->rxData, readLength );
+        ( void ) memcpy( &response[ ( uint32_t ) headerLength + readLength ], "\r\nOK\r\n", 6U );
+
+        if( _simQueueOutput( ( const uint8_t * ) response, ( uint32_t ) headerLength + readLength + 6U,
+                             simConfig.defaultLatencyMs + _simTransferMs( readLength ), false ) )
+        {
+            ( void ) memmove( pSocket->rxData, &pSocket->rxData[ readLength ], pSocket->rxLength - readLength );
+            pSocket->rxLength -= readLength;
+            pSocket->totalRead += readLength;
+            simContext.stats.socketBytesRead += readLength;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void _simHandleClose( const char * pParams )
+{
+    uint32_t socketId = 0;
+
+    if( ( _simParseNumbers( pParams, &socketId, 1U ) ) && ( socketId < CELLULAR_BG770_SIM_SOCKET_COUNT ) )
+    {
+        simContext.sockets[ socketId ].rxLength = 0;
+        simContext.sockets[ socketId ].totalRead = 0;
+    }
+
+    ( void ) _simQueueLines( "OK", simConfig.defaultLatencyMs, false );
+}
+
+/*-----------------------------------------------------------*/
+
+/* AT+QIDNSGIP=<contextID>,"<hostname>", every name resolves to one address with a TTL of 600 s. */
+static void _simHandleDns( void )
+{
+    char urc[ 48 ] = { '\0' };
+    uint32_t delayMs = ( simConfig.dnsLatencyMs > simConfig.defaultLatencyMs ) ?
+                       simConfig.dnsLatencyMs : simConfig.defaultLatencyMs;
+
+    simContext.dnsQueryCount++;
+    ( void ) _simQueueLines( "OK", simConfig.defaultLatencyMs, false );
+    ( void ) _simQueueLines( "+QIURC: \"dnsgip\",0,1,600", delayMs, true );
+    ( void ) snprintf( urc, sizeof( urc ), "+QIURC: \"dnsgip\",\"10.1.%u.%u\"",
+                       ( unsigned int ) ( ( simContext.dnsQueryCount >> 8 ) & 0xFFU ),
+                       ( unsigned int ) ( simContext.dnsQueryCount & 0xFFU ) );
+    ( void ) _simQueueLines( urc, delayMs, true );
+    simContext.stats.urcCount += 2U;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with simMutex held for a complete command line. */
+static void _simHandleCommand( void )
+{
+    const CellularBg770SimRule_t * pRule = NULL;
+    const char * pCommand = simContext.command;
+    uint16_t i = 0;
+
+    simContext.stats.commandCount++;
+
+    for( i = 0; ( i < simConfig.ruleCount ) && ( pRule == NULL ); i++ )
+    {
+        if( strncmp( pCommand, simConfig.pRules[ i ].pCommandPrefix, strlen( simConfig.pRules[ i ].pCommandPrefix ) ) == 0 )
+        {
+            pRule = &simConfig.pRules[ i ];
+            simContext.stats.scriptedResponseCount++;
+        }
+    }
+
+    if( pRule != NULL )
+    {
+        ( void ) _simQueueLines( pRule->pResponse, simConfig.defaultLatencyMs + pRule->latencyMs, false );
+    }
+    else if( strncmp( pCommand, "AT+QIOPEN=", 10 ) == 0 )
+    {
+        _simHandleOpen( &pCommand[ 10 ], false );
+    }
+    else if( strncmp( pCommand, "AT+QSSLOPEN=", 12 ) == 0 )
+    {
+        _simHandleOpen( &pCommand[ 12 ], true );
+    }
+    else if( strncmp( pCommand, "AT+QISEND=", 10 ) == 0 )
+    {
+        _simHandleSend( &pCommand[ 10 ] );
+    }
+    else if( strncmp( pCommand, "AT+QSSLSEND=", 12 ) == 0 )
+    {
+        _simHandleSend( &pCommand[ 12 ] );
+    }
+    else if( strncmp( pCommand, "AT+QIRD=", 8 ) == 0 )
+    {
+        _simHandleRead( &pCommand[ 8 ], false );
+    }
+    else if( strncmp( pCommand, "AT+QSSLRECV=", 12 ) == 0 )
+    {
+        _simHandleRead( &pCommand[ 12 ], true );
+    }
+    else if( strncmp( pCommand, "AT+QICLOSE=", 11 ) == 0 )
+    {
+        _simHandleClose( &pCommand[ 11 ] );
+    }
+    else if( strncmp( pCommand, "AT+QSSLCLOSE=", 13 ) == 0 )
+    {
+        _simHandleClose( &pCommand[ 13 ] );
+    }
+    else if( strncmp( pCommand, "AT+QIDNSGIP=", 12 ) == 0 )
+    {
+        _simHandleDns();
+    }
+    else
+    {
+        for( i = 0; ( i < ( sizeof( _simDefaultRules ) / sizeof( _simDefaultRules[ 0 ] ) ) ) && ( pRule == NULL ); i++ )
+        {
+            if( strncmp( pCommand, _simDefaultRules[ i ].pCommandPrefix, strlen( _simDefaultRules[ i ].pCommandPrefix ) ) == 0 )
+            {
+                pRule = &_simDefaultRules[ i ];
+            }
+        }
+
+        ( void ) _simQueueLines( ( pRule != NULL ) ? pRule->pResponse : "OK", simConfig.defaultLatencyMs, false );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Moves due output to the port and signals it, the receive callback runs outside simMutex. */
+static void _simThread( void * pArgument )
+{
+    simPendingOutput_t * pOutput = NULL;
+    EventBits_t uxBits = 0;
+    bool delivered = false;
+    uint16_t i = 0;
+
+    ( void ) pArgument;
+
+    for( ; ; )
+    {
+        uxBits = ( EventBits_t ) PlatformEventGroup_WaitBits( simContext.pSimEvent,
+                                                              ( PlatformEventGroup_EventBits ) SIM_EVT_MASK_STOP,
+                                                              pdFALSE, pdFALSE,
+                                                              pdMS_TO_TICKS( CELLULAR_BG770_SIM_TICK_MS ) );
+
+        if( ( uxBits & ( EventBits_t ) SIM_EVT_MASK_STOP ) != 0U )
+        {
+            break;
+        }
+
+        delivered = false;
+        PlatformMutex_Lock( &simContext.simMutex );
+
+        pOutput = _simNextOutput();
+
+        /* The simulated clock skips to the next output, or to an earlier wake time of a delayed task. */
+        if( ( simConfig.simulatedClock ) && ( pOutput != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            _simClockAdvanceTo( pOutput->dueTicks );
+            taskEXIT_CRITICAL();
+        }
+
+        while( pOutput != NULL )
+        {
+            if( ( ( int32_t ) ( _simNow() - pOutput->dueTicks ) < 0 ) ||
+                ( ( simContext.outputCount + pOutput->length ) > SIM_OUTPUT_BUFFER_SIZE ) )
+            {
+                break;
+            }
+
+            for( i = 0; i < pOutput->length; i++ )
+            {
+                simContext.output[ ( simContext.outputHead + simContext.outputCount ) % SIM_OUTPUT_BUFFER_SIZE ] = pOutput->data[ i ];
+                simContext.outputCount++;
+            }
+
+            pOutput->inUse = false;
+            simContext.pendingCount--;
+            delivered = true;
+            pOutput = _simNextOutput();
+        }
+
+        _simClockSetOutputBound( pOutput );
+        PlatformMutex_Unlock( &simContext.simMutex );
+
+        if( delivered )
+        {
+            ( void ) PlatformEventGroup_SetBits( simContext.pSimEvent, ( PlatformEventGroup_EventBits ) SIM_EVT_MASK_RX_READY );
+
+            if( simContext.receiveCallback != NULL )
+            {
+                ( void ) simContext.receiveCallback( simContext.pUserData,
+                                                     ( CellularCommInterfaceHandle_t ) &simContext );
+            }
+        }
+    }
+
+    ( void ) PlatformEventGroup_SetBits( simContext.pSimEvent, ( PlatformEventGroup_EventBits ) SIM_EVT_MASK_STOPPED );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularCommInterfaceError_t _simOpen( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                              void * pUserData,
+                                              CellularCommInterfaceHandle_t * pCommInterfaceHandle )
+{
+    CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+    bool mutexCreated = false;
+
+    if( ( receiveCallback == NULL ) || ( pCommInterfaceHandle == NULL ) )
+    {
+        commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+    }
+    else if( simContext.opened )
+    {
+        commIntRet = IOT_COMM_INTERFACE_FAILURE;
+    }
+    else
+    {
+        ( void ) memset( &simContext, 0, sizeof( simContext_t ) );
+        simContext.receiveCallback = receiveCallback;
+        simContext.pUserData = pUserData;
+        mutexCreated = PlatformMutex_Create( &simContext.simMutex, false );
+        simContext.pSimEvent = ( PlatformEventGroupHandle_t ) PlatformEventGroup_Create();
+
+        if( ( mutexCreated == false ) || ( simContext.pSimEvent == NULL ) )
+        {
+            commIntRet = IOT_COMM_INTERFACE_NO_MEMORY;
+        }
+        else if( Platform_CreateDetachedThread( _simThread, NULL, CELLULAR_BG770_SIM_PRIORITY,
+                                                CELLULAR_BG770_SIM_STACK_SIZE ) != true )
+        {
+            commIntRet = IOT_COMM_INTERFACE_DRIVER_ERROR;
+        }
+        else
+        {
+            if( simConfig.bootDelayMs != 0U )
+            {
+                ( void ) _simQueueLines( "RDY", simConfig.bootDelayMs, true );
+                ( void ) _simQueueLines( "APP RDY", simConfig.bootDelayMs, true );
+                simContext.stats.urcCount += 2U;
+            }
+
+            simContext.opened = true;
+            *pCommInterfaceHandle = ( CellularCommInterfaceHandle_t ) &simContext;
+        }
+
+        if( commIntRet != IOT_COMM_INTERFACE_SUCCESS )
+        {
+            if( simContext.pSimEvent != NULL )
+            {
+                ( void ) PlatformEventGroup_Delete( simContext.pSimEvent );
+                simContext.pSimEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+            }
+
+            if( mutexCreated )
+            {
+                PlatformMutex_Destroy( &simContext.simMutex );
+            }
+        }
+    }
+
+    return commIntRet;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularCommInterfaceError_t _simSend( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                              const uint8_t * pData,
+                                              uint32_t dataLength,
+                                              uint32_t timeoutMilliseconds,
+                                              uint32_t * pDataSentLength )
+{
+    CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+    uint32_t i = 0;
+
+    ( void ) timeoutMilliseconds;
+
+    if( ( commInterfaceHandle != ( CellularCommInterfaceHandle_t ) &simContext ) || ( simContext.opened == false ) )
+    {
+        commIntRet = IOT_COMM_INTERFACE_FAILURE;
+    }
+    else if( ( pData == NULL ) || ( pDataSentLength == NULL ) )
+    {
+        commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+    }
+    else
+    {
+        PlatformMutex_Lock( &simContext.simMutex );
+        simContext.stats.bytesFromHost += dataLength;
+
+        for( i = 0; i < dataLength; i++ )
+        {
+            if( simContext.inputState == SIM_INPUT_SEND_DATA )
+            {
+                simContext.sendRemaining--;
+
+                if( simContext.sendRemaining == 0U )
+                {
+                    _simHandleSendComplete();
+                }
+            }
+            else if( ( pData[ i ] == ( uint8_t ) '\r' ) || ( pData[ i ] == ( uint8_t ) '\n' ) )
+            {
+                if( simContext.commandOverflow )
+                {
+                    ( void ) _simQueueLines( "ERROR", simConfig.defaultLatencyMs, false );
+                }
+                else if( simContext.commandLength > 0U )
+                {
+                    simContext.command[ simContext.commandLength ] = '\0';
+                    _simHandleCommand();
+                }
+                else
+                {
+                    /* Empty else MISRA 15.7 */
+                }
+
+                simContext.commandLength = 0;
+                simContext.commandOverflow = false;
+            }
+            else if( simContext.commandLength < ( CELLULAR_BG770_SIM_MAX_COMMAND_LENGTH - 1U ) )
+            {
+                simContext.command[ simContext.commandLength ] = ( char ) pData[ i ];
+                simContext.commandLength++;
+            }
+            else
+            {
+                /* Overlong command, the modem answers ERROR once the line ends. */
+                simContext.commandOverflow = true;
+            }
+        }
+
+        PlatformMutex_Unlock( &simContext.simMutex );
+        *pDataSentLength = dataLength;
+    }
+
+    return commIntRet;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularCommInterfaceError_t _simRecv( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                              uint8_t * pBuffer,
+                                              uint32_t bufferLength,
+                                              uint32_t timeoutMilliseconds,
+                                              uint32_t * pDataReceivedLength )
+{
+    CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+    uint32_t length = 0;
+
+    if( ( commInterfaceHandle != ( CellularCommInterfaceHandle_t ) &simContext ) || ( simContext.opened == false ) )
+    {
+        commIntRet = IOT_COMM_INTERFACE_FAILURE;
+    }
+    else if( ( pBuffer == NULL ) || ( pDataReceivedLength == NULL ) || ( bufferLength == 0U ) )
+    {
+        commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+    }
+    else
+    {
+        if( ( simContext.outputCount == 0U ) && ( timeoutMilliseconds != 0U ) )
+        {
+            ( void ) PlatformEventGroup_WaitBits( simContext.pSimEvent,
+                                                  ( PlatformEventGroup_EventBits ) SIM_EVT_MASK_RX_READY,
+                                                  pdTRUE, pdFALSE, pdMS_TO_TICKS( timeoutMilliseconds ) );
+        }
+
+        PlatformMutex_Lock( &simContext.simMutex );
+
+        while( ( length < bufferLength ) && ( simContext.outputCount > 0U ) )
+        {
+            pBuffer[ length ] = simContext.output[ simContext.outputHead ];
+            simContext.outputHead = ( simContext.outputHead + 1U ) % SIM_OUTPUT_BUFFER_SIZE;
+            simContext.outputCount--;
+            length++;
+        }
+
+        simContext.stats.bytesToHost += length;
+        PlatformMutex_Unlock( &simContext.simMutex );
+
+        *pDataReceivedLength = length;
+
+        if( length == 0U )
+        {
+            commIntRet = IOT_COMM_INTERFACE_TIMEOUT;
+        }
+    }
+
+    return commIntRet;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularCommInterfaceError_t _simClose( CellularCommInterfaceHandle_t commInterfaceHandle )
+{
+    CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+    EventBits_t uxBits = 0;
+
+    if( ( commInterfaceHandle != ( CellularCommInterfaceHandle_t ) &simContext ) || ( simContext.opened == false ) )
+    {
+        commIntRet = IOT_COMM_INTERFACE_FAILURE;
+    }
+    else
+    {
+        ( void ) PlatformEventGroup_SetBits( simContext.pSimEvent, ( PlatformEventGroup_EventBits ) SIM_EVT_MASK_STOP );
+        uxBits = ( EventBits_t ) PlatformEventGroup_WaitBits( simContext.pSimEvent,
+                                                              ( PlatformEventGroup_EventBits ) SIM_EVT_MASK_STOPPED,
+                                                              pdFALSE, pdFALSE, SIM_STOP_TIMEOUT_ticks );
+
+        if( ( uxBits & ( EventBits_t ) SIM_EVT_MASK_STOPPED ) == 0U )
+        {
+            commIntRet = IOT_COMM_INTERFACE_TIMEOUT;
+        }
+        else
+        {
+            /* Outputs never sent no longer hold the clock back. */
+            _simClockSetOutputBound( NULL );
+            simContext.opened = false;
+            ( void ) PlatformEventGroup_Delete( simContext.pSimEvent );
+            simContext.pSimEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+            PlatformMutex_Destroy( &simContext.simMutex );
+        }
+    }
+
+    return commIntRet;
+}
+
+/*-----------------------------------------------------------*/
+
+void CellularBg770Sim_Configure( const CellularBg770SimConfig_t * pConfig )
+{
+    simConfig = ( pConfig != NULL ) ? *pConfig : _simDefaultConfig;
+}
+
+/*-----------------------------------------------------------*/
+
+bool CellularBg770Sim_InjectUrc( const char * pUrc,
+                                 uint32_t delayMs )
+{
+    bool queued = false;
+
+    if( ( pUrc != NULL ) && ( simContext.opened ) )
+    {
+        PlatformMutex_Lock( &simContext.simMutex );
+        queued = _simQueueLines( pUrc, delayMs, true );
+
+        if( queued )
+        {
+            simContext.stats.urcCount++;
+        }
+
+        PlatformMutex_Unlock( &simContext.simMutex );
+    }
+
+    return queued;
+}
+
+/*-----------------------------------------------------------*/
+
+bool CellularBg770Sim_InjectSocketData( uint8_t socketId,
+                                        const uint8_t * pData,
+                                        uint32_t dataLength )
+{
+    simSocket_t * pSocket = NULL;
+    uint32_t copyLength = 0;
+    char urc[ 32 ] = { '\0' };
+    bool allQueued = false;
+
+    if( ( pData != NULL ) && ( socketId < CELLULAR_BG770_SIM_SOCKET_COUNT ) && ( simContext.opened ) )
+    {
+        PlatformMutex_Lock( &simContext.simMutex );
+        pSocket = &simContext.sockets[ socketId ];
+        copyLength = CELLULAR_BG770_SIM_SOCKET_BUFFER_SIZE - pSocket->rxLength;
+
+        if( copyLength > dataLength )
+        {
+            copyLength = dataLength;
+        }
+
+        ( void ) memcpy( &pSocket->rxData[ pSocket->rxLength ], pData, copyLength );
+        pSocket->rxLength += copyLength;
+        allQueued = ( copyLength == dataLength );
+
+        /* The data is on air before the modem reports it. */
+        ( void ) snprintf( urc, sizeof( urc ), "+QIURC: \"recv\",%u", ( unsigned int ) socketId );
+
+        if( _simQueueLines( urc, _simTransferMs( copyLength ), true ) )
+        {
+            simContext.stats.urcCount++;
+        }
+
+        PlatformMutex_Unlock( &simContext.simMutex );
+    }
+
+    return allQueued;
+}
+
+/*-----------------------------------------------------------*/
+
+void CellularBg770Sim_AdvanceClock( TickType_t ticks )
+{
+    taskENTER_CRITICAL();
+    simClockTicks += ticks;
+    taskEXIT_CRITICAL();
+}
+
+/*-----------------------------------------------------------*/
+
+void CellularBg770Sim_GetStats( CellularBg770SimStats_t * pStats )
+{
+    if( pStats != NULL )
+    {
+        if( simContext.opened )
+        {
+            PlatformMutex_Lock( &simContext.simMutex );
+            *pStats = simContext.stats;
+            PlatformMutex_Unlock( &simContext.simMutex );
+        }
+        else
+        {
+            *pStats = simContext.stats;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
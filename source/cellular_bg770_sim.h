@@ -0,0 +1,195 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+#ifndef __CELLULAR_BG770_SIM_H__
+#define __CELLULAR_BG770_SIM_H__
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Host-side BG770 emulator. It replaces the UART as the CellularCommInterface_t passed to Cellular_Init(),
+ * so the port can run against a scripted modem. Echo is taken as off, the port sends ATE0 first. */
+
+#include "cellular_platform.h"
+#include "cellular_types.h"
+#include "cellular_comm_interface.h"
+#include "cellular_bg770.h"
+
+#ifndef CELLULAR_BG770_SIM_SOCKET_COUNT
+    #define CELLULAR_BG770_SIM_SOCKET_COUNT          ( 12U )
+#endif
+
+/* Received data the emulator holds per socket until AT+QIRD reads it. */
+#ifndef CELLULAR_BG770_SIM_SOCKET_BUFFER_SIZE
+    #define CELLULAR_BG770_SIM_SOCKET_BUFFER_SIZE    ( 4096U )
+#endif
+
+/* Responses and URCs waiting for their latency to expire. Responses keep their order, a URC goes out when its own
+ * delay expires. */
+#ifndef CELLULAR_BG770_SIM_PENDING_OUTPUT_COUNT
+    #define CELLULAR_BG770_SIM_PENDING_OUTPUT_COUNT  ( 8U )
+#endif
+
+/* Longest single response, large enough for a full AT+QIRD read. */
+#ifndef CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH
+    #define CELLULAR_BG770_SIM_MAX_OUTPUT_LENGTH     ( 1600U )
+#endif
+
+#ifndef CELLULAR_BG770_SIM_MAX_COMMAND_LENGTH
+    #define CELLULAR_BG770_SIM_MAX_COMMAND_LENGTH    ( 256U )
+#endif
+
+#ifndef CELLULAR_BG770_SIM_TICK_MS
+    #define CELLULAR_BG770_SIM_TICK_MS               ( 1U )
+#endif
+
+/* Tasks that can be in a simulated clock delay at the same time. */
+#ifndef CELLULAR_BG770_SIM_CLOCK_WAITER_COUNT
+    #define CELLULAR_BG770_SIM_CLOCK_WAITER_COUNT    ( 8U )
+#endif
+
+#ifndef CELLULAR_BG770_SIM_STACK_SIZE
+    #define CELLULAR_BG770_SIM_STACK_SIZE            ( PLATFORM_THREAD_DEFAULT_STACK_SIZE )
+#endif
+
+#ifndef CELLULAR_BG770_SIM_PRIORITY
+    #define CELLULAR_BG770_SIM_PRIORITY              ( PLATFORM_THREAD_DEFAULT_PRIORITY )
+#endif
+
+/**
+ * @brief A scripted answer. The first rule whose prefix starts the command wins, ahead of the built-in answers.
+ */
+typedef struct CellularBg770SimRule
+{
+    const char * pCommandPrefix;  /* For example "AT+QCSQ". */
+    const char * pResponse;       /* Lines separated by "\r\n", for example "+QCSQ: \"eMTC\",-70,-95,150,-10\r\nOK". */
+    uint32_t latencyMs;           /* Added to defaultLatencyMs. */
+} CellularBg770SimRule_t;
+
+/**
+ * @brief Emulator settings, applied by the next open.
+ */
+typedef struct CellularBg770SimConfig
+{
+    uint32_t defaultLatencyMs;          /* Time from a command to its response. */
+    uint32_t bootDelayMs;               /* Time from open to RDY and APP RDY, 0 for none. */
+    uint32_t throughputBytesPerSecond;  /* Socket send and read rate, 0 for unlimited. */
+    uint32_t connectLatencyMs;          /* Time from AT+QIOPEN to its +QIOPEN URC. */
+    uint32_t dnsLatencyMs;              /* Time from AT+QIDNSGIP to its "dnsgip" URCs. */
+    const CellularBg770SimRule_t * pRules;
+    uint16_t ruleCount;
+    bool simulatedClock;                /* Time latencies on CellularBg770SimClock instead of the kernel. */
+} CellularBg770SimConfig_t;
+
+/**
+ * @brief Emulator counters.
+ */
+typedef struct CellularBg770SimStats
+{
+    uint32_t commandCount;
+    uint32_t scriptedResponseCount;
+    uint32_t urcCount;
+    uint32_t bytesFromHost;
+    uint32_t bytesToHost;
+    uint32_t socketBytesSent;      /* Payload of completed AT+QISEND. */
+    uint32_t socketBytesRead;      /* Payload returned by AT+QIRD. */
+    uint32_t droppedOutputCount;   /* Responses lost because the pending output was full. */
+} CellularBg770SimStats_t;
+
+/**
+ * @brief The emulator as a comm interface for Cellular_Init().
+ */
+extern CellularCommInterface_t CellularBg770SimCommInterface;
+
+/**
+ * @brief A deterministic simulated clock for CellularModule_SetClock().
+ *
+ * The clock only moves forward to the earliest pending deadline: the wake time of a task in a delay or, with
+ * simulatedClock set, the next emulator output. Delayed tasks therefore wake in order of their wake times, and
+ * scenarios with long delays run in real milliseconds. Each delay still blocks for one real tick before the
+ * clock moves, so the port's waits on events, which poll the clock in 10 ms steps, take a real tick per step.
+ * A task busy without a delay is not waited for, the clock moves on while it runs.
+ *
+ * Only the port runs on this clock. Timeouts inside the common library, such as DATA_SEND_TIMEOUT_MS and the
+ * operator selection timeout, are out of scope and still use the kernel tick. The emulator answers on the
+ * simulated clock, so they only take real time in a scenario where the modem does not answer.
+ */
+extern const CellularBg770Clock_t CellularBg770SimClock;
+
+/**
+ * @brief Move the simulated clock forward, for example past an idle timeout.
+ *
+ * @param[in] ticks The ticks to add.
+ */
+void CellularBg770Sim_AdvanceClock( TickType_t ticks );
+
+/**
+ * @brief Set the emulator behaviour. Call before Cellular_Init().
+ *
+ * @param[in] pConfig The settings, NULL for the defaults. The rules are referenced, not copied.
+ */
+void CellularBg770Sim_Configure( const CellularBg770SimConfig_t * pConfig );
+
+/**
+ * @brief Send a URC to the port, for example "+QIND: \"csq\",20,99" or "+CEREG: 5".
+ *
+ * @param[in] pUrc The URC line without line endings.
+ * @param[in] delayMs Time until it is sent.
+ *
+ * @return true if it was queued.
+ */
+bool CellularBg770Sim_InjectUrc( const char * pUrc,
+                                 uint32_t delayMs );
+
+/**
+ * @brief Queue data received on a socket and send the +QIURC "recv" URC for it.
+ *
+ * @param[in] socketId The BG770 connect ID.
+ * @param[in] pData The data.
+ * @param[in] dataLength The data length.
+ *
+ * @return true if all of the data fit in the socket buffer.
+ */
+bool CellularBg770Sim_InjectSocketData( uint8_t socketId,
+                                        const uint8_t * pData,
+                                        uint32_t dataLength );
+
+/**
+ * @brief Retrieve the emulator counters.
+ *
+ * @param[out] pStats Out parameter to provide the counters.
+ */
+void CellularBg770Sim_GetStats( CellularBg770SimStats_t * pStats );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* ifndef __CELLULAR_BG770_SIM_H__ */
@@ -40,6 +40,65 @@
 
 /*-----------------------------------------------------------*/
 
+#define URC_WORKER_EVT_MASK_STOPPED         ( 0x0001UL )
+#define URC_WORKER_STOP_TIMEOUT_ticks       ( pdMS_TO_TICKS( 10000U ) )    /* Between warnings, the stop itself is waited for. */
+
+/* +CEREG: <stat>[,[<tac>],[<ci>],[<AcT>]] fits with room to spare. */
+#define CEREG_URC_PAYLOAD_MAX_SIZE          ( 64U )
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Application notifications produced by URC handlers.
+ *
+ * Handlers update the port state inline and describe the callback to run with one of these
+ * records, so the callback can be run on the URC worker thread when deferred dispatch is enabled.
+ */
+typedef enum cellularUrcEventType
+{
+    CELLULAR_URC_EVENT_TYPE_SOCKET_OPEN,
+    CELLULAR_URC_EVENT_TYPE_SOCKET_DATA_READY,
+    CELLULAR_URC_EVENT_TYPE_SOCKET_CLOSED,
+    CELLULAR_URC_EVENT_TYPE_PDN,
+    CELLULAR_URC_EVENT_TYPE_SIGNAL_STRENGTH,
+    CELLULAR_URC_EVENT_TYPE_MODEM,
+    CELLULAR_URC_EVENT_TYPE_SIM_STATE,
+    CELLULAR_URC_EVENT_TYPE_PSM_TIMELINE,
+    CELLULAR_URC_EVENT_TYPE_WORKER_STOP
+} cellularUrcEventType_t;
+
+typedef enum cellularPsmTimelineUpdate
+{
+    CELLULAR_PSM_TIMELINE_TIMERS,   /* QPSMTIMER reported the network assigned timers. */
+    CELLULAR_PSM_TIMELINE_ENTERED,  /* PSM POWER DOWN. */
+    CELLULAR_PSM_TIMELINE_WOKE      /* RDY, the modem is up again. */
+} cellularPsmTimelineUpdate_t;
+
+typedef struct cellularUrcEventRecord
+{
+    cellularUrcEventType_t eventType;
+    union
+    {
+        struct
+        {
+            uint32_t sockIndex;
+            uint32_t generation;  /* Socket generation when posted. */
+            CellularUrcEvent_t urcEvent;
+        } socket;
+        struct
+        {
+            CellularUrcEvent_t urcEvent;
+            uint8_t contextId;
+        } pdn;
+        CellularSignalInfo_t signalInfo;
+        CellularModemEvent_t modemEvent;
+        CellularSimCardState_t simCardState;
+        CellularPsmTimeline_t psmTimeline;
+    } data;
+} cellularUrcEventRecord_t;
+
+/*-----------------------------------------------------------*/
+
 static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
                                         char * pInputLine );
 static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
@@ -71,6 +130,22 @@ static void _Cellular_ProcessCereg( CellularContext_t * pContext,
 static void _Cellular_ProcessCreg( CellularContext_t * pContext,
                                    char * pInputLine );
 
+#ifdef CELLULAR_BG770_URC_DEFERRED_DISPATCH
+    static bool _isSocketEventRecord( const cellularUrcEventRecord_t * pEventRecord );
+    static bool _isStaleSocketEvent( const CellularContext_t * pContext,
+                                     const cellularUrcEventRecord_t * pEventRecord );
+#endif
+static void _dispatchUrcEvent( const CellularContext_t * pContext,
+                               const cellularUrcEventRecord_t * pEventRecord );
+static void _postUrcEvent( const CellularContext_t * pContext,
+                           const cellularUrcEventRecord_t * pEventRecord );
+static void _postModemEvent( const CellularContext_t * pContext,
+                             CellularModemEvent_t modemEvent );
+static void _updatePsmTimeline( const CellularContext_t * pContext,
+                                cellularPsmTimelineUpdate_t update,
+                                uint32_t periodicTauSeconds,
+                                uint32_t activeTimeSeconds );
+
 /*-----------------------------------------------------------*/
 
 /* Try to Keep this map in Alphabetical order. */
@@ -100,11 +175,473 @@ uint32_t CellularUrcHandlerTableSize = sizeof( CellularUrcHandlerTable ) / sizeo
 
 /*-----------------------------------------------------------*/
 
+#ifdef CELLULAR_BG770_URC_DEFERRED_DISPATCH
+
+static bool _isSocketEventRecord( const cellularUrcEventRecord_t * pEventRecord )
+{
+    return ( ( pEventRecord->eventType == CELLULAR_URC_EVENT_TYPE_SOCKET_OPEN ) ||
+             ( pEventRecord->eventType == CELLULAR_URC_EVENT_TYPE_SOCKET_DATA_READY ) ||
+             ( pEventRecord->eventType == CELLULAR_URC_EVENT_TYPE_SOCKET_CLOSED ) ) ? true : false;
+}
+
+/*-----------------------------------------------------------*/
+
+/* A socket closed after the record was posted may have its index reused by a new socket,
+ * the generation tells the two apart. Counts the drop. */
+static bool _isStaleSocketEvent( const CellularContext_t * pContext,
+                                 const cellularUrcEventRecord_t * pEventRecord )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool stale = false;
+
+    if( ( _isSocketEventRecord( pEventRecord ) ) &&
+        ( pEventRecord->data.socket.sockIndex < CELLULAR_NUM_SOCKET_MAX ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->urcDispatchMutex );
+
+        if( pModuleContext->socketGeneration[ pEventRecord->data.socket.sockIndex ] != pEventRecord->data.socket.generation )
+        {
+            pModuleContext->urcDispatchStats.staleDroppedCount++;
+            stale = true;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->urcDispatchMutex );
+    }
+
+    if( stale )
+    {
+        LogDebug( ( "_isStaleSocketEvent: socket %u closed since event type %d was posted",
+                    pEventRecord->data.socket.sockIndex, pEventRecord->eventType ) );
+    }
+
+    return stale;
+}
+
+#endif /* CELLULAR_BG770_URC_DEFERRED_DISPATCH */
+
+/*-----------------------------------------------------------*/
+
+/* Deliver an URC event to the application callbacks. Socket events look the socket up again
+ * by index, the socket may have been removed while the record was queued. */
+static void _dispatchUrcEvent( const CellularContext_t * pContext,
+                               const cellularUrcEventRecord_t * pEventRecord )
+{
+    CellularSocketContext_t * pSocketData = NULL;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularUrcSimStateChangedCallback_t simStateChangedCallback = NULL;
+    void * pSimStateChangedCallbackContext = NULL;
+    CellularPsmTimelineCallback_t psmTimelineCallback = NULL;
+    void * pPsmTimelineCallbackContext = NULL;
+
+    switch( pEventRecord->eventType )
+    {
+        case CELLULAR_URC_EVENT_TYPE_SOCKET_OPEN:
+            pSocketData = _Cellular_GetSocketData( pContext, pEventRecord->data.socket.sockIndex );
+
+            if( ( pSocketData != NULL ) && ( pSocketData->openCallback != NULL ) )
+            {
+                pSocketData->openCallback( pEventRecord->data.socket.urcEvent,
+                                           pSocketData, pSocketData->pOpenCallbackContext );
+            }
+
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_SOCKET_DATA_READY:
+            pSocketData = _Cellular_GetSocketData( pContext, pEventRecord->data.socket.sockIndex );
+
+            if( ( pSocketData != NULL ) && ( pSocketData->dataReadyCallback != NULL ) )
+            {
+                pSocketData->dataReadyCallback( pSocketData, pSocketData->pDataReadyCallbackContext );
+            }
+
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_SOCKET_CLOSED:
+            pSocketData = _Cellular_GetSocketData( pContext, pEventRecord->data.socket.sockIndex );
+
+            if( ( pSocketData != NULL ) && ( pSocketData->closedCallback != NULL ) )
+            {
+                pSocketData->closedCallback( pSocketData, pSocketData->pClosedCallbackContext );
+            }
+
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_PDN:
+            _Cellular_PdnEventCallback( pContext, pEventRecord->data.pdn.urcEvent, pEventRecord->data.pdn.contextId );
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_SIGNAL_STRENGTH:
+            _Cellular_SignalStrengthChangedCallback( pContext, CELLULAR_URC_EVENT_SIGNAL_CHANGED,
+                                                     &pEventRecord->data.signalInfo );
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_MODEM:
+            _Cellular_ModemEventCallback( pContext, pEventRecord->data.modemEvent );
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_SIM_STATE:
+
+            if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+                simStateChangedCallback = pModuleContext->simStateChangedCallback;
+                pSimStateChangedCallbackContext = pModuleContext->pSimStateChangedCallbackContext;
+                PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+            }
+
+            if( simStateChangedCallback != NULL )
+            {
+                simStateChangedCallback( pEventRecord->data.simCardState, pSimStateChangedCallbackContext );
+            }
+
+            break;
+
+        case CELLULAR_URC_EVENT_TYPE_PSM_TIMELINE:
+
+            if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Lock( &pModuleContext->psmMutex );
+                psmTimelineCallback = pModuleContext->psmTimelineCallback;
+                pPsmTimelineCallbackContext = pModuleContext->pPsmTimelineCallbackContext;
+                PlatformMutex_Unlock( &pModuleContext->psmMutex );
+            }
+
+            if( psmTimelineCallback != NULL )
+            {
+                psmTimelineCallback( &pEventRecord->data.psmTimeline, pPsmTimelineCallbackContext );
+            }
+
+            break;
+
+        default:
+            LogWarn( ( "_dispatchUrcEvent: unexpected event type %d", pEventRecord->eventType ) );
+            break;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called on the pktio reader thread. In deferred mode the record is queued without blocking,
+ * otherwise it is dispatched in place as before. */
+static void _postUrcEvent( const CellularContext_t * pContext,
+                           const cellularUrcEventRecord_t * pEventRecord )
+{
+#ifdef CELLULAR_BG770_URC_DEFERRED_DISPATCH
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularUrcEventRecord_t eventRecord = { 0 };
+    uint32_t queuedCount = 0;
+    bool posted = false;
+
+    if( ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) &&
+        ( pModuleContext != NULL ) && ( pModuleContext->urcEventQueue != NULL ) )
+    {
+        eventRecord = *pEventRecord;
+
+        PlatformMutex_Lock( &pModuleContext->urcDispatchMutex );
+
+        if( ( _isSocketEventRecord( &eventRecord ) ) && ( eventRecord.data.socket.sockIndex < CELLULAR_NUM_SOCKET_MAX ) )
+        {
+            eventRecord.data.socket.generation = pModuleContext->socketGeneration[ eventRecord.data.socket.sockIndex ];
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->urcDispatchMutex );
+
+        posted = ( xQueueSend( pModuleContext->urcEventQueue, &eventRecord, ( TickType_t ) 0 ) == pdPASS ) ? true : false;
+        queuedCount = ( uint32_t ) uxQueueMessagesWaiting( pModuleContext->urcEventQueue );
+
+        PlatformMutex_Lock( &pModuleContext->urcDispatchMutex );
+
+        if( posted )
+        {
+            pModuleContext->urcDispatchStats.postedCount++;
+
+            if( queuedCount > pModuleContext->urcDispatchStats.highWaterMark )
+            {
+                pModuleContext->urcDispatchStats.highWaterMark = queuedCount;
+            }
+        }
+        else
+        {
+            pModuleContext->urcDispatchStats.overflowCount++;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->urcDispatchMutex );
+
+        if( posted == false )
+        {
+            LogWarn( ( "_postUrcEvent: URC event queue full, event type %d dropped", pEventRecord->eventType ) );
+        }
+    }
+    else
+    {
+        _dispatchUrcEvent( pContext, pEventRecord );
+    }
+#else
+    _dispatchUrcEvent( pContext, pEventRecord );
+#endif /* CELLULAR_BG770_URC_DEFERRED_DISPATCH */
+}
+
+/*-----------------------------------------------------------*/
+
+static void _postModemEvent( const CellularContext_t * pContext,
+                             CellularModemEvent_t modemEvent )
+{
+    cellularUrcEventRecord_t eventRecord = { 0 };
+
+    eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_MODEM;
+    eventRecord.data.modemEvent = modemEvent;
+    _postUrcEvent( pContext, &eventRecord );
+}
+
+/*-----------------------------------------------------------*/
+
+/* T3412 extended runs up to 320 hours times 31, more ms than 32 bits hold and more ticks than the wrap safe
+ * comparisons allow. Later predictions are clamped to half the tick range, they are refreshed before then. */
+static TickType_t _psmSecondsToTicks( uint32_t seconds )
+{
+    uint64_t ticks = ( ( uint64_t ) seconds * ( uint64_t ) configTICK_RATE_HZ );
+
+    if( ticks > ( uint64_t ) ( portMAX_DELAY / 2U ) )
+    {
+        ticks = ( uint64_t ) ( portMAX_DELAY / 2U );
+    }
+
+    return ( TickType_t ) ticks;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The active timer T3324 and the periodic TAU timer T3412 both start when the modem goes idle, which is
+ * approximated by the last wake up. The timers are only used once the network has reported them. */
+static void _updatePsmTimeline( const CellularContext_t * pContext,
+                                cellularPsmTimelineUpdate_t update,
+                                uint32_t periodicTauSeconds,
+                                uint32_t activeTimeSeconds )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularPsmTimeline_t * pTimeline = NULL;
+    cellularUrcEventRecord_t eventRecord = { 0 };
+    const TickType_t nowTicks = _Cellular_GetTicks();
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->psmMutex );
+        pTimeline = &pModuleContext->psmTimeline;
+
+        switch( update )
+        {
+            case CELLULAR_PSM_TIMELINE_TIMERS:
+                pTimeline->timersKnown = true;
+                pTimeline->periodicTauSeconds = periodicTauSeconds;
+                pTimeline->activeTimeSeconds = activeTimeSeconds;
+                pTimeline->timersReceivedTicks = nowTicks;
+
+                if( pTimeline->inPsm == false )
+                {
+                    pTimeline->lastWakeTicks = nowTicks;
+                }
+
+                break;
+
+            case CELLULAR_PSM_TIMELINE_ENTERED:
+                pTimeline->inPsm = true;
+                pTimeline->psmEnteredTicks = nowTicks;
+                pTimeline->psmEntryCount++;
+                break;
+
+            case CELLULAR_PSM_TIMELINE_WOKE:
+            default:
+                pTimeline->inPsm = false;
+                pTimeline->lastWakeTicks = nowTicks;
+                break;
+        }
+
+        if( pTimeline->timersKnown )
+        {
+            pTimeline->nextPsmEntryTicks = pTimeline->lastWakeTicks + _psmSecondsToTicks( pTimeline->activeTimeSeconds );
+
+            /* In PSM the remaining TAU time is counted from the entry, T3412 having started T3324 earlier. */
+            if( ( pTimeline->inPsm ) && ( pTimeline->periodicTauSeconds > pTimeline->activeTimeSeconds ) )
+            {
+                pTimeline->nextTauWakeTicks = pTimeline->psmEnteredTicks +
+                                              _psmSecondsToTicks( pTimeline->periodicTauSeconds - pTimeline->activeTimeSeconds );
+            }
+            else if( pTimeline->inPsm )
+            {
+                /* T3324 not shorter than T3412, the modem is due for its TAU as it enters PSM. */
+                pTimeline->nextTauWakeTicks = pTimeline->psmEnteredTicks;
+            }
+            else
+            {
+                pTimeline->nextTauWakeTicks = pTimeline->lastWakeTicks + _psmSecondsToTicks( pTimeline->periodicTauSeconds );
+            }
+        }
+
+        eventRecord.data.psmTimeline = *pTimeline;
+        PlatformMutex_Unlock( &pModuleContext->psmMutex );
+
+        eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_PSM_TIMELINE;
+        _postUrcEvent( pContext, &eventRecord );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#ifdef CELLULAR_BG770_URC_DEFERRED_DISPATCH
+
+static void _urcEventWorkerThread( void * pArgument )
+{
+    cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pArgument;
+    cellularUrcEventRecord_t eventRecord = { 0 };
+    bool running = true;
+
+    while( running )
+    {
+        if( xQueueReceive( pModuleContext->urcEventQueue, &eventRecord, portMAX_DELAY ) == pdTRUE )
+        {
+            if( eventRecord.eventType == CELLULAR_URC_EVENT_TYPE_WORKER_STOP )
+            {
+                running = false;
+            }
+            else if( _isStaleSocketEvent( pModuleContext->pUrcEventContext, &eventRecord ) )
+            {
+                /* The socket index now belongs to another socket or to none. */
+            }
+            else
+            {
+                _dispatchUrcEvent( pModuleContext->pUrcEventContext, &eventRecord );
+
+                PlatformMutex_Lock( &pModuleContext->urcDispatchMutex );
+                pModuleContext->urcDispatchStats.dispatchedCount++;
+                PlatformMutex_Unlock( &pModuleContext->urcDispatchMutex );
+            }
+        }
+    }
+
+    ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pUrcWorkerEvent,
+                                         ( PlatformEventGroup_EventBits ) URC_WORKER_EVT_MASK_STOPPED );
+}
+
+#endif /* CELLULAR_BG770_URC_DEFERRED_DISPATCH */
+
+/*-----------------------------------------------------------*/
+
+CellularError_t _Cellular_UrcDispatchInit( const CellularContext_t * pContext,
+                                           cellularModuleContext_t * pModuleContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+#ifdef CELLULAR_BG770_URC_DEFERRED_DISPATCH
+    pModuleContext->pUrcEventContext = pContext;
+    pModuleContext->urcEventQueue = xQueueCreate( CELLULAR_BG770_URC_EVENT_QUEUE_LENGTH,
+                                                  sizeof( cellularUrcEventRecord_t ) );
+
+    if( pModuleContext->urcEventQueue == NULL )
+    {
+        cellularStatus = CELLULAR_NO_MEMORY;
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pModuleContext->pUrcWorkerEvent = ( PlatformEventGroupHandle_t ) PlatformEventGroup_Create();
+
+        if( pModuleContext->pUrcWorkerEvent == NULL )
+        {
+            cellularStatus = CELLULAR_NO_MEMORY;
+        }
+        else
+        {
+            ( void ) PlatformEventGroup_ClearBits( ( PlatformEventGroupHandle_t ) pModuleContext->pUrcWorkerEvent,
+                                                   ( PlatformEventGroup_EventBits ) URC_WORKER_EVT_MASK_STOPPED );
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( Platform_CreateDetachedThread( _urcEventWorkerThread, ( void * ) pModuleContext,
+                                           CELLULAR_BG770_URC_WORKER_PRIORITY,
+                                           CELLULAR_BG770_URC_WORKER_STACK_SIZE ) != true )
+        {
+            LogError( ( "_Cellular_UrcDispatchInit: failed to create URC worker thread" ) );
+            cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+        }
+    }
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        if( pModuleContext->urcEventQueue != NULL )
+        {
+            vQueueDelete( pModuleContext->urcEventQueue );
+            pModuleContext->urcEventQueue = NULL;
+        }
+
+        if( pModuleContext->pUrcWorkerEvent != NULL )
+        {
+            ( void ) PlatformEventGroup_Delete( pModuleContext->pUrcWorkerEvent );
+            pModuleContext->pUrcWorkerEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+        }
+    }
+#else
+    ( void ) pContext;
+    ( void ) pModuleContext;
+#endif /* CELLULAR_BG770_URC_DEFERRED_DISPATCH */
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_UrcDispatchCleanUp( cellularModuleContext_t * pModuleContext )
+{
+#ifdef CELLULAR_BG770_URC_DEFERRED_DISPATCH
+    cellularUrcEventRecord_t stopRecord = { 0 };
+    PlatformEventGroup_EventBits uxBits = 0;
+
+    if( pModuleContext->urcEventQueue != NULL )
+    {
+        /* Records already queued are still delivered, the stop record goes in behind them. The worker
+         * blocks on the queue the caller deletes next, it is joined whatever it takes. */
+        stopRecord.eventType = CELLULAR_URC_EVENT_TYPE_WORKER_STOP;
+
+        while( _Cellular_QueueSend( pModuleContext->urcEventQueue, &stopRecord, URC_WORKER_STOP_TIMEOUT_ticks ) != pdPASS )
+        {
+            LogWarn( ( "_Cellular_UrcDispatchCleanUp: Still waiting to queue the stop record for the URC worker" ) );
+        }
+
+        while( ( uxBits & URC_WORKER_EVT_MASK_STOPPED ) == 0U )
+        {
+            uxBits = _Cellular_WaitBits( ( PlatformEventGroupHandle_t ) pModuleContext->pUrcWorkerEvent,
+                                         ( PlatformEventGroup_EventBits ) URC_WORKER_EVT_MASK_STOPPED,
+                                         pdTRUE,
+                                         URC_WORKER_STOP_TIMEOUT_ticks );
+
+            if( ( uxBits & URC_WORKER_EVT_MASK_STOPPED ) == 0U )
+            {
+                LogWarn( ( "_Cellular_UrcDispatchCleanUp: Still waiting for the URC worker to stop" ) );
+            }
+        }
+
+        vQueueDelete( pModuleContext->urcEventQueue );
+        ( void ) PlatformEventGroup_Delete( pModuleContext->pUrcWorkerEvent );
+        pModuleContext->urcEventQueue = NULL;
+        pModuleContext->pUrcWorkerEvent = ( PlatformEventGroupHandle_t ) ( uintptr_t ) ( uintptr_t * ) NULL;
+    }
+#else
+    ( void ) pModuleContext;
+#endif /* CELLULAR_BG770_URC_DEFERRED_DISPATCH */
+}
+
+/*-----------------------------------------------------------*/
+
 /* internal function of _parseSocketOpen to reduce complexity. */
-static CellularPktStatus_t _parseSocketOpenNextTok( const char * pToken,
+static CellularPktStatus_t _parseSocketOpenNextTok( const CellularContext_t * pContext,
+                                                    const char * pToken,
                                                     uint32_t sockIndex,
                                                     CellularSocketContext_t * pSocketData )
 {
+    cellularUrcEventRecord_t eventRecord = { 0 };
+
     int32_t sockStatus = 0;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
@@ -127,16 +664,11 @@ static CellularPktStatus_t _parseSocketOpenNextTok( const char * pToken,
         /* Indicate the upper layer about the socket open status. */
         if( pSocketData->openCallback != NULL )
         {
-            if( sockStatus != 0 )
-            {
-                pSocketData->openCallback( CELLULAR_URC_SOCKET_OPEN_FAILED,
-                                           pSocketData, pSocketData->pOpenCallbackContext );
-            }
-            else
-            {
-                pSocketData->openCallback( CELLULAR_URC_SOCKET_OPENED,
-                                           pSocketData, pSocketData->pOpenCallbackContext );
-            }
+            eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_SOCKET_OPEN;
+            eventRecord.data.socket.sockIndex = sockIndex;
+            eventRecord.data.socket.urcEvent = ( sockStatus != 0 ) ? CELLULAR_URC_SOCKET_OPEN_FAILED :
+                                                                     CELLULAR_URC_SOCKET_OPENED;
+            _postUrcEvent( pContext, &eventRecord );
         }
         else
         {
@@ -213,7 +745,7 @@ static void _Cellular_ProcessSocketOpen( CellularContext_t * pContext,
 
                 if( atCoreStatus == CELLULAR_AT_SUCCESS )
                 {
-                    pktStatus = _parseSocketOpenNextTok( pToken, sockIndex, pSocketData );
+                    pktStatus = _parseSocketOpenNextTok( pContext, pToken, sockIndex, pSocketData );
                 }
             }
             else
@@ -299,7 +831,7 @@ static void _Cellular_ProcessSSLSocketOpen( CellularContext_t * pContext,
 
                 if( atCoreStatus == CELLULAR_AT_SUCCESS )
                 {
-                    pktStatus = _parseSocketOpenNextTok( pToken, sockIndex, pSocketData );
+                    pktStatus = _parseSocketOpenNextTok( pContext, pToken, sockIndex, pSocketData );
                 }
             }
             else
@@ -332,6 +864,8 @@ static CellularPktStatus_t _parseUrcIndicationCsq( const CellularContext_t * pCo
     int32_t retStrtoi = 0;
     int16_t csqRssi = CELLULAR_INVALID_SIGNAL_VALUE, csqBer = CELLULAR_INVALID_SIGNAL_VALUE;
     CellularSignalInfo_t signalInfo = { 0 };
+    cellularUrcEventRecord_t eventRecord = { 0 };
+    cellularModuleContext_t * pModuleContext = NULL;
     char * pLocalUrcStr = pUrcStr;
 
     if( ( pContext == NULL ) || ( pUrcStr == NULL ) )
@@ -403,7 +937,15 @@ static CellularPktStatus_t _parseUrcIndicationCsq( const CellularContext_t * pCo
         signalInfo.rsrq = CELLULAR_INVALID_SIGNAL_VALUE;
         signalInfo.ber = csqBer;
         signalInfo.bars = CELLULAR_INVALID_SIGNAL_BAR_VALUE;
-        _Cellular_SignalStrengthChangedCallback( pContext, CELLULAR_URC_EVENT_SIGNAL_CHANGED, &signalInfo );
+
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_SignalHistoryAdd( pModuleContext, &signalInfo );
+        }
+
+        eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_SIGNAL_STRENGTH;
+        eventRecord.data.signalInfo = signalInfo;
+        _postUrcEvent( pContext, &eventRecord );
     }
 
     if( atCoreStatus != CELLULAR_AT_SUCCESS )
@@ -471,12 +1013,18 @@ static void _Cellular_ProcessIndication( CellularContext_t * pContext,
 
 /*-----------------------------------------------------------*/
 
-static void _informDataReadyToUpperLayer( CellularSocketContext_t * pSocketData )
+static void _informDataReadyToUpperLayer( const CellularContext_t * pContext,
+                                          uint32_t sockIndex,
+                                          const CellularSocketContext_t * pSocketData )
 {
+    cellularUrcEventRecord_t eventRecord = { 0 };
+
     /* Indicate the upper layer about the data reception. */
     if( ( pSocketData != NULL ) && ( pSocketData->dataReadyCallback != NULL ) )
     {
-        pSocketData->dataReadyCallback( pSocketData, pSocketData->pDataReadyCallbackContext );
+        eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_SOCKET_DATA_READY;
+        eventRecord.data.socket.sockIndex = sockIndex;
+        _postUrcEvent( pContext, &eventRecord );
     }
     else
     {
@@ -527,7 +1075,9 @@ static CellularPktStatus_t _parseSocketUrcRecv( const CellularContext_t * pConte
             {
                 /* Data received indication in buffer mode, need to fetch the data. */
                 LogDebug( ( "Data Received on socket Conn Id %d", sockIndex ) );
-                _informDataReadyToUpperLayer( pSocketData );
+                _Cellular_IdleTrackerUpdate( pContext, CELLULAR_IDLE_ACTIVITY_RECV_PENDING, sockIndex );
+                _Cellular_EdrxNotePaged( pContext );
+                _informDataReadyToUpperLayer( pContext, sockIndex, pSocketData );
             }
         }
         else
@@ -554,6 +1104,7 @@ static CellularPktStatus_t _parseSocketUrcClosed( const CellularContext_t * pCon
     int32_t tempValue = 0;
     uint32_t sockIndex = 0;
     CellularSocketContext_t * pSocketData = NULL;
+    cellularUrcEventRecord_t eventRecord = { 0 };
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
 
@@ -589,7 +1140,9 @@ static CellularPktStatus_t _parseSocketUrcClosed( const CellularContext_t * pCon
             /* Indicate the upper layer about the socket close. */
             if( pSocketData->closedCallback != NULL )
             {
-                pSocketData->closedCallback( pSocketData, pSocketData->pClosedCallbackContext );
+                eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_SOCKET_CLOSED;
+                eventRecord.data.socket.sockIndex = sockIndex;
+                _postUrcEvent( pContext, &eventRecord );
             }
             else
             {
@@ -619,6 +1172,8 @@ static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContex
     char * pToken = NULL;
     char * pLocalUrcStr = pUrcStr;
     uint8_t contextId = 0;
+    cellularUrcEventRecord_t eventRecord = { 0 };
+    cellularModuleContext_t * pModuleContext = NULL;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
 
@@ -639,8 +1194,18 @@ static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContex
             if( _Cellular_IsValidPdn( contextId ) == CELLULAR_SUCCESS )
             {
                 LogDebug( ( "PDN deactivated. Context Id %d", contextId ) );
+
+                if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+                {
+                    _Cellular_DnsCacheInvalidate( pModuleContext, contextId );
+                    _Cellular_DnsQueriesAbort( pModuleContext, contextId );
+                }
+
                 /* Indicate the upper layer about the PDN deactivate. */
-                _Cellular_PdnEventCallback( pContext, CELLULAR_URC_EVENT_PDN_DEACTIVATED, contextId );
+                eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_PDN;
+                eventRecord.data.pdn.urcEvent = CELLULAR_URC_EVENT_PDN_DEACTIVATED;
+                eventRecord.data.pdn.contextId = contextId;
+                _postUrcEvent( pContext, &eventRecord );
             }
             else
             {
@@ -850,13 +1415,60 @@ static void _Cellular_ProcessSimstat( CellularContext_t * pContext,
                                       char * pInputLine )
 {
     CellularSimCardState_t simCardState = CELLULAR_SIM_CARD_UNKNOWN;
+    bool urcEnabled = false;
+    cellularModuleContext_t * pModuleContext = NULL;
 
     if( pContext != NULL )
     {
-        ( void ) _Cellular_ParseSimstat( pInputLine, &simCardState );
+        /* The SIM was inserted or removed, its identity is read again on the next request. */
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_IdentityCacheInvalidate( pModuleContext, false );
+        }
+
+        if( _Cellular_ParseSimstat( pInputLine, &simCardState, &urcEnabled ) == CELLULAR_PKT_STATUS_OK )
+        {
+            _Cellular_SimStateUpdate( pContext, simCardState, urcEnabled );
+        }
     }
+}
+
+/*-----------------------------------------------------------*/
 
-    // FUTURE: This goes nowhere? What's the point?
+/* Track the SIM insertion state reported by the QSIMSTAT URC or an AT+QSIMSTAT? poll and
+ * notify the application when it changes. */
+void _Cellular_SimStateUpdate( const CellularContext_t * pContext,
+                               CellularSimCardState_t simCardState,
+                               bool urcEnabled )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularUrcEventRecord_t eventRecord = { 0 };
+    bool changed = false;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->identityCacheMutex );
+
+        /* simCardState keeps the last known state, an unknown report only clears simStateKnown. */
+        if( ( simCardState != CELLULAR_SIM_CARD_UNKNOWN ) && ( simCardState != pModuleContext->simCardState ) )
+        {
+            changed = true;
+            pModuleContext->simStateChangeCount++;
+            pModuleContext->simCardState = simCardState;
+        }
+
+        pModuleContext->simStateKnown = ( simCardState != CELLULAR_SIM_CARD_UNKNOWN );
+        pModuleContext->simStateUrcEnabled = urcEnabled;
+        PlatformMutex_Unlock( &pModuleContext->identityCacheMutex );
+    }
+
+    if( changed )
+    {
+        LogInfo( ( "_Cellular_SimStateUpdate: SIM state changed to %d", simCardState ) );
+        eventRecord.eventType = CELLULAR_URC_EVENT_TYPE_SIM_STATE;
+        eventRecord.data.simCardState = simCardState;
+        _postUrcEvent( pContext, &eventRecord );
+    }
 }
 
 /*-----------------------------------------------------------*/
@@ -876,7 +1488,7 @@ static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessPowerDown: Modem Power down event received" ) );
-        _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_POWERED_DOWN );
+        _postModemEvent( pContext, CELLULAR_MODEM_EVENT_POWERED_DOWN );
     }
 }
 
@@ -897,7 +1509,8 @@ static void _Cellular_ProcessPsmPowerDown( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessPsmPowerDown: Modem PSM power down event received" ) );
-        _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_PSM_ENTER );
+        _updatePsmTimeline( pContext, CELLULAR_PSM_TIMELINE_ENTERED, 0, 0 );
+        _postModemEvent( pContext, CELLULAR_MODEM_EVENT_PSM_ENTER );
     }
 }
 
@@ -906,8 +1519,21 @@ static void _Cellular_ProcessPsmPowerDown( CellularContext_t * pContext,
 static void _Cellular_ProcessCereg( CellularContext_t * pContext,
                                     char * pInputLine )
 {
+    char ceregPayload[ CEREG_URC_PAYLOAD_MAX_SIZE + 1U ] = { '\0' };
+
+    /* The common handler tokenizes the line in place, keep a copy for the serving cell cache. */
+    if( pInputLine != NULL )
+    {
+        ( void ) strncpy( ceregPayload, pInputLine, CEREG_URC_PAYLOAD_MAX_SIZE );
+    }
+
     // FUTURE: Handle return value?
     Cellular_CommonUrcProcessCereg( pContext, pInputLine );
+
+    if( ( pContext != NULL ) && ( ceregPayload[ 0 ] != '\0' ) )
+    {
+        _Cellular_ServingCellUpdateFromCereg( pContext, ceregPayload );
+    }
 }
 
 /*-----------------------------------------------------------*/
@@ -926,18 +1552,59 @@ static void _Cellular_ProcessCreg( CellularContext_t * pContext,
 static void _Cellular_ProcessPSMTimerurc(CellularContext_t * pContext,
                                          char * pInputLine )
 {
-    /* No need to process the pInputLine, no interface to get timer info at this point. */
-    ( void ) pInputLine;
+    char * pLocalInputLine = pInputLine;
+    char * pToken = NULL;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    uint32_t periodicTauSeconds = 0;
+    uint32_t activeTimeSeconds = 0;
 
     if( pContext == NULL )
     {
         LogError( ( "_Cellular_ProcessPSMTimerurc: Context not set" ) );
     }
+    else if( pInputLine == NULL )
+    {
+        LogError( ( "_Cellular_ProcessPSMTimerurc: Input line not set" ) );
+    }
     else
     {
-        // FUTURE: Pass timer info through modem event callback
         LogDebug( ( "_Cellular_ProcessPSMTimerurc: Modem PSM timer event received, '%s'", pInputLine ) );
-        _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_PSM_TIMER );
+
+        /* +QPSMTIMER: <TAU_timer>,<T3324_timer>, both in seconds. */
+        atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pLocalInputLine );
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATGetNextTok( &pLocalInputLine, &pToken );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATStrtoui( pToken, 10, &periodicTauSeconds );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATGetNextTok( &pLocalInputLine, &pToken );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATStrtoui( pToken, 10, &activeTimeSeconds );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            /* T3324 can not outlast T3412, clamp so the timeline arithmetic stays sane. */
+            activeTimeSeconds = ( activeTimeSeconds > periodicTauSeconds ) ? periodicTauSeconds : activeTimeSeconds;
+            _updatePsmTimeline( pContext, CELLULAR_PSM_TIMELINE_TIMERS, periodicTauSeconds, activeTimeSeconds );
+        }
+        else
+        {
+            LogError( ( "_Cellular_ProcessPSMTimerurc: Error in processing QPSMTIMER" ) );
+        }
+
+        _postModemEvent( pContext, CELLULAR_MODEM_EVENT_PSM_TIMER );
     }
 }
 
@@ -948,6 +1615,8 @@ static void _Cellular_ProcessPSMTimerurc(CellularContext_t * pContext,
 static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
                                        char * pInputLine )
 {
+    cellularModuleContext_t * pModuleContext = NULL;
+
     /* The token is the pInputLine. No need to process the pInputLine. */
     ( void ) pInputLine;
 
@@ -958,7 +1627,17 @@ static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessModemRdy: Modem Ready event received" ) );
-        _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_BOOTUP_OR_REBOOT );
+
+        /* The modem restarted, possibly with new firmware or a new SIM. */
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_IdentityCacheInvalidate( pModuleContext, true );
+            _Cellular_ServingCellInvalidate( pModuleContext );
+            _Cellular_DnsQueriesAbort( pModuleContext, 0U );
+        }
+
+        _updatePsmTimeline( pContext, CELLULAR_PSM_TIMELINE_WOKE, 0, 0 );
+        _postModemEvent( pContext, CELLULAR_MODEM_EVENT_BOOTUP_OR_REBOOT );
     }
 }
 
@@ -979,12 +1658,15 @@ static void _Cellular_ProcessModemAppRdy( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessModemRdy: Modem App Ready event received" ) );
-        _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_BOOTUP_OR_REBOOT );
+        _postModemEvent( pContext, CELLULAR_MODEM_EVENT_BOOTUP_OR_REBOOT );
 
         cellularModuleContext_t * pModuleContext = NULL;
         CellularError_t cellularStatus = _Cellular_GetModuleContext( pContext, (void **)&pModuleContext );
         if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pModuleContext != NULL ) )
         {
+            _Cellular_IdentityCacheInvalidate( pModuleContext, true );
+            _Cellular_ServingCellInvalidate( pModuleContext );
+            _Cellular_DnsQueriesAbort( pModuleContext, 0U );
             ( void ) PlatformEventGroup_SetBits( ( PlatformEventGroupHandle_t ) pModuleContext->pInitEvent, ( EventBits_t ) INIT_EVT_MASK_APP_RDY_RECEIVED );
         }
         else
@@ -999,7 +1681,8 @@ static void _Cellular_ProcessModemAppRdy( CellularContext_t * pContext,
 /* Cellular common prototype. */
 /* coverity[misra_c_2012_rule_8_13_violation] */
 CellularPktStatus_t _Cellular_ParseSimstat( char * pInputStr,
-                                            CellularSimCardState_t * pSimState )
+                                            CellularSimCardState_t * pSimState,
+                                            bool * pUrcEnabled )
 {
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
@@ -1020,6 +1703,13 @@ CellularPktStatus_t _Cellular_ParseSimstat( char * pInputStr,
         if( atCoreStatus == CELLULAR_AT_SUCCESS )
         {
             LogDebug( ( "QSIMSTAT URC Enable: %s", pToken ) );
+
+            /* Optional, the caller may only want the insertion state. */
+            if( pUrcEnabled != NULL )
+            {
+                *pUrcEnabled = ( strcmp( pToken, "1" ) == 0 );
+            }
+
             atCoreStatus = Cellular_ATGetNextTok( &pLocalInputStr, &pToken );
         }
 